@@ -0,0 +1,128 @@
+/*
+ * File:   engineScoreboard.cpp
+ *
+ * Runs every search engine of ./a.out on input files with known good
+ * schedules, such as the planted schedules of ./generator, for each of a
+ * list of time budgets, and prints the optimality gap of the schedule found
+ * against the reference schedule, one row per engine and budget:
+ *
+ *   input engine minutes seconds score gap
+ *
+ * The gap is (reference - score) / reference, so it is the optimality gap
+ * when the reference is optimal, and below zero when an engine beats it.
+ *
+ * Usage: ./scoreboard <minutes>[,<minutes>...] <input_filename> <reference_filename>...
+ * ./a.out and ./validator are run from the directory of the scoreboard.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+
+// the seed of every run, so the engines are compared on the same draws
+#define SCOREBOARD_SEED 1
+
+/**
+ * Score a schedule file with the validator.
+ * @return false if the schedule is not valid
+ */
+static bool scoreSchedule(const string &directory, const string &inputFileName, const string &scheduleFileName, double &score)
+{
+	string command = directory + "/validator " + inputFileName + " " + scheduleFileName;
+	FILE *validator = popen(command.c_str(), "r");
+	if(validator == NULL)
+		return false;
+
+	bool valid = false;
+	char line[4096];
+	if(fgets(line, sizeof(line), validator) != NULL)
+	{
+		const char *value = strstr(line, "\"score\":");
+		valid = strstr(line, "\"valid\":true") != NULL && value != NULL;
+		if(valid)
+			score = atof(value + strlen("\"score\":"));
+	}
+	pclose(validator);
+	return valid;
+}
+
+/**
+ * Run an engine of the organizer on an input file for a time budget.
+ * @return the wall clock seconds of the run
+ */
+static double runEngine(const string &directory, const string &inputFileName, const string &engine, const string &minutes, const string &outputFileName)
+{
+	string command = directory + "/a.out " + inputFileName + " " + outputFileName + " --mode " + engine
+		+ " --time " + minutes + " --seed " + to_string(SCOREBOARD_SEED) + " > /dev/null 2>&1";
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if(system(command.c_str()) == -1)
+		cout << "Unable to run " << command << endl;
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 4 || argc % 2 != 0)
+	{
+		cout << "./scoreboard <minutes>[,<minutes>...] <input_filename> <reference_filename>..." << endl;
+		return 2;
+	}
+
+	string argument0(argv[0]);
+	string directory = argument0.find('/') == string::npos ? "." : argument0.substr(0, argument0.rfind('/'));
+	string outputFileName = "/tmp/scoreboard_" + to_string(getpid()) + "_output.txt";
+
+	vector<string> budgets;
+	stringstream budgetList(argv[1]);
+	for(string budget; getline(budgetList, budget, ',');)
+		budgets.push_back(budget);
+
+	// the engines share the cores, so they are run one after the other
+	const char *engines[] = { "beam", "climb", "lns", "memetic", "portfolio" };
+	printf("%-32s %-10s %8s %8s %12s %9s\n", "input", "engine", "minutes", "seconds", "score", "gap");
+
+	for(int instance = 2; instance + 1 < argc; instance += 2)
+	{
+		string inputFileName(argv[instance]);
+		double reference;
+		if(!scoreSchedule(directory, inputFileName, argv[instance + 1], reference) || reference == 0.0)
+		{
+			cout << "Skipping " << inputFileName << ", its reference " << argv[instance + 1] << " is not a valid schedule" << endl;
+			continue;
+		}
+
+		for(int engine = 0; engine < sizeof(engines) / sizeof(engines[0]); engine++)
+		{
+			for(int i = 0; i < budgets.size(); i++)
+			{
+				remove(outputFileName.c_str());
+				double seconds = runEngine(directory, inputFileName, engines[engine], budgets[i], outputFileName);
+
+				double score;
+				if(scoreSchedule(directory, inputFileName, outputFileName, score))
+					printf("%-32s %-10s %8s %8.1f %12.2f %8.3f%%\n", inputFileName.c_str(), engines[engine], budgets[i].c_str(),
+						seconds, score, 100.0 * (reference - score) / reference);
+				else
+					printf("%-32s %-10s %8s %8.1f %12s %9s\n", inputFileName.c_str(), engines[engine], budgets[i].c_str(),
+						seconds, "invalid", "-");
+				fflush(stdout);
+
+				// a run that did not finish leaves its checkpoint behind
+				remove((outputFileName + ".checkpoint").c_str());
+				remove((outputFileName + ".checkpoint.tmp").c_str());
+			}
+		}
+	}
+
+	remove(outputFileName.c_str());
+	return 0;
+}
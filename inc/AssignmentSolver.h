@@ -0,0 +1,30 @@
+/*
+ * File:   AssignmentSolver.h
+ *
+ */
+
+#ifndef ASSIGNMENTSOLVER_H
+#define	ASSIGNMENTSOLVER_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * AssignmentSolver solves the square min-cost assignment problem with the
+ * Hungarian algorithm in O(n^3).
+ */
+class AssignmentSolver {
+public:
+    /**
+     * Assign every row to a distinct column at minimum total cost.
+     *
+     * @param cost is the n x n cost matrix, cost[row][column].
+     * @param assignment receives the column assigned to every row.
+     * @return the total cost of the assignment.
+     */
+    static double solve(const vector< vector<double> > &cost, vector<int> &assignment);
+};
+
+#endif	/* ASSIGNMENTSOLVER_H */
+
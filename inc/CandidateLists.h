@@ -0,0 +1,86 @@
+/*
+ * File:   CandidateLists.h
+ *
+ */
+
+#ifndef CANDIDATELISTS_H
+#define	CANDIDATELISTS_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * CandidateLists holds, for every paper, the papers most similar to it (the
+ * smallest distances) and the papers most dissimilar to it (the largest
+ * distances). Moves that bring similar papers together or put dissimilar
+ * papers in parallel are drawn from these lists.
+ */
+class CandidateLists {
+private:
+    int numberOfPapers;
+    int listSize;
+
+    // listSize papers for every paper, the closest or farthest first
+    vector<int> similarPapers;
+    vector<int> dissimilarPapers;
+
+    /**
+     * Build the lists of the papers in [firstPaper, lastPaper) with the given stride.
+     */
+    void buildRows(double **distanceMatrix, int firstPaper, int stride);
+
+public:
+    CandidateLists();
+
+    /**
+     * Build the lists from the distance matrix, the rows split between threads.
+     *
+     * @param distanceMatrix is the distance matrix of the papers.
+     * @param numberOfPapers is the number of papers.
+     * @param listSize is the number of papers in each list.
+     * @param numberOfThreads is the number of threads to use.
+     */
+    void build(double **distanceMatrix, int numberOfPapers, int listSize, int numberOfThreads);
+
+    /**
+     * Start empty lists, to be built a row at a time with buildRow.
+     *
+     * @param numberOfPapers is the number of papers.
+     * @param listSize is the number of papers in each list.
+     */
+    void init(int numberOfPapers, int listSize);
+
+    /**
+     * Build the lists of one paper from its row of distances. Rows of
+     * different papers may be built by different threads at the same time.
+     *
+     * @param distances the row of distances of the paper
+     * @param paperId the id of the paper
+     * @param others scratch space of the calling thread
+     */
+    void buildRow(const double *distances, int paperId, vector<int> &others);
+
+    /**
+     * returns the number of papers in each list
+     * @return the size of the lists, 0 if they are not built
+     */
+    int getListSize();
+
+    /**
+     * Gets the papers most similar to a paper, the most similar first.
+     * @param paperId the id of the paper
+     * @return the array of getListSize() papers
+     */
+    const int* getSimilarPapers(int paperId);
+
+    /**
+     * Gets the papers most dissimilar to a paper, the most dissimilar first.
+     * @param paperId the id of the paper
+     * @return the array of getListSize() papers
+     */
+    const int* getDissimilarPapers(int paperId);
+};
+
+#endif	/* CANDIDATELISTS_H */
+
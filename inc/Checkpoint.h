@@ -0,0 +1,106 @@
+/*
+ * File:   Checkpoint.h
+ *
+ */
+
+#ifndef CHECKPOINT_H
+#define	CHECKPOINT_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Checkpoint is a compact binary image of the state of a search, so a run
+ * that is stopped can be resumed. The search thread puts its state into a
+ * buffer, field after field, and save hands the buffer to a background
+ * thread that writes it to a temporary file and renames that over the
+ * checkpoint, so a run killed while writing keeps the previous checkpoint.
+ *
+ * Fields are read back by load and the get functions in the order they were
+ * put, in the byte order of the machine that wrote them.
+ */
+class Checkpoint {
+private:
+    // the fields put since the last save, or read by load
+    vector<char> buffer;
+    size_t readPosition;
+
+    // the buffer being written by the background thread
+    vector<char> pending;
+    thread writer;
+    atomic<bool> writing;
+
+    /**
+     * Write the pending buffer to the file, then rename it into place.
+     */
+    void write(string fileName);
+
+    /**
+     * Copy the next bytes of the buffer.
+     * @return false if the buffer holds fewer bytes
+     */
+    bool get(void *data, size_t size);
+
+public:
+    Checkpoint();
+    ~Checkpoint();
+
+    /**
+     * Remove every field.
+     */
+    void clear();
+
+    /**
+     * Append a field to the buffer.
+     */
+    void putInteger(long long value);
+    void putDouble(double value);
+    void putString(const string &value);
+    void putPapers(const vector<int> &papers);
+
+    /**
+     * Read the next field of the buffer.
+     * @return false if the buffer ends before it
+     */
+    bool getInteger(long long &value);
+    bool getDouble(double &value);
+    bool getString(string &value);
+    bool getPapers(vector<int> &papers);
+
+    /**
+     * Write the buffer to a file in the background, and clear it. Nothing is
+     * written while an earlier save is still being written.
+     *
+     * @param fileName is the name of the checkpoint file
+     * @return false if an earlier save is still being written
+     */
+    bool save(const string &fileName);
+
+    /**
+     * Read a checkpoint file into the buffer, for the get functions.
+     *
+     * @param fileName is the name of the checkpoint file
+     * @return false if the file can not be read or is not a checkpoint
+     */
+    bool load(const string &fileName);
+
+    /**
+     * Wait until the last save is written.
+     */
+    void wait();
+
+    /**
+     * Wait until the last save is written, then delete the checkpoint file
+     * and any temporary file left by a save that was cut short.
+     *
+     * @param fileName is the name of the checkpoint file
+     */
+    void remove(const string &fileName);
+};
+
+#endif	/* CHECKPOINT_H */
+
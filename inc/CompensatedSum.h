@@ -0,0 +1,47 @@
+/*
+ * File:   CompensatedSum.h
+ *
+ */
+
+#ifndef COMPENSATEDSUM_H
+#define	COMPENSATEDSUM_H
+
+#include <cmath>
+
+/**
+ * A sum of doubles with the rounding error of every addition carried along
+ * (Kahan-Babuska-Neumaier), so that the error does not grow with the number
+ * of terms.
+ */
+class CompensatedSum {
+private:
+    double sum;
+    double compensation;
+
+public:
+    CompensatedSum() : sum(0.0), compensation(0.0) {}
+
+    /**
+     * Add a term to the sum
+     */
+    inline void add(double value)
+    {
+        double total = sum + value;
+        if(std::fabs(sum) >= std::fabs(value))
+            compensation += (sum - total) + value;
+        else
+            compensation += (value - total) + sum;
+        sum = total;
+    }
+
+    /**
+     * returns the sum of the terms added
+     */
+    inline double getSum() const
+    {
+        return sum + compensation;
+    }
+};
+
+#endif	/* COMPENSATEDSUM_H */
+
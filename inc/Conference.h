@@ -1,145 +1,220 @@
-/* 
- * File:   Conference.h
- * Author: Harishchandra Patidar
- *
- * Created on 18 August, 2015, 1:00 PM
- */
-
-#ifndef CONFERENCE_H
-#define	CONFERENCE_H
-
-#include<iostream>
-using namespace std;
-
-#include "Track.h"
-
-class Conference {
-private:
-    // The array of tracks.
-    Track *tracks;
-
-    // The number of parallel tracks.
-    int parallelTracks;
-
-    // The number of sessions in a track.
-    int sessionsInTrack;
-
-    // The number of papers in a session.
-    int papersInSession;
-
-    // score of the conference
-    double score;
-
-public:
-    Conference();
-    ~Conference();
-    
-    /**
-     * Constructor for Conference.
-     * 
-     * @param parallelTracks is the number of parallel tracks.
-     * @param sessionsInTrack is the number of sessions in a track.
-     * @param papersInSession is the number of papers in a session.
-     */
-    Conference(int parallelTracks, int sessionsInTrack, int papersInSession);
-
-    /**
-     * Copy Constructor
-     */
-    Conference(const Conference& anotherConference);
-
-    /**
-     * Assignment Operator
-     */
-    Conference & operator=(const Conference &anotherConference);
-
-    /**
-     * Less than Operator
-     */
-    bool operator < (const Conference &rhs);
-    
-    
-    /**
-     * Initialize the tracks.
-     * @param parallelTracks is the number of parallel tracks.
-     * @param sessionsInTrack is the number of sessions in a track.
-     * @param papersInSession is the number of papers in a session.
-     */
-    void initTracks(int parallelTracks, int sessionsInTrack, int papersInSession);
-    
-    
-    /**
-     * returns the number of parallel tracks.
-     * @return the number of parallel tracks.
-     */
-    int getParallelTracks();
-    
-    
-    /**
-     * returns the number of sessions in a track.
-     * @return the number of sessions in a track.
-     */
-    int getSessionsInTrack();
-    
-    
-    /**
-     * returns the number of papers in a session.
-     * @return the number of papers in a session.
-     */
-    int getPapersInSession();
-
-    /**
-     * returns the score of the conference
-     * @return the score of the conference
-     */
-    double getScore();
-
-    /**
-     * increase the score of conference
-     * @param deltaScore value to be added to score
-     */
-    void increaseScore(double deltaScore);
-    
-    
-    /**
-     * Gets the track at the specified index.
-     * @param trackIndex the index of the specified track.
-     * @return the track
-     */
-    Track* getTrack(int trackIndex);
-
-    /**
-     * Gets the session specified by indexes
-     * @param trackIndex the index of the track
-     * @param sessionIndex the index of the specified session
-     * @return the session
-     */
-    Session* getSession(int trackIndex, int sessionIndex);
-
-    /**
-     * Gets the paper specified by indexes
-     * @param trackIndex the index of the track
-     * @param sessionIndex the index of the session
-     * @param paperIndex the index of the specified paper
-     * @return the paper
-     */
-    int getPaper(int trackIndex, int sessionIndex, int paperIndex);
-    
-    
-    /**
-     * Sets the paper in the specified slot to the given paper id.
-     * @param trackIndex the index of the track
-     * @param sessionIndex the index of the session
-     * @param paperIndex the index of the paper
-     * @param paperId the id of the paper.
-     */
-    void setPaper(int trackIndex, int sessionIndex, int paperIndex, int paperId);
-    
-    /**
-     * Prints the conference
-     */
-    void printConference();
-};
-
-#endif	/* CONFERENCE_H */
-
+/* 
+ * File:   Conference.h
+ * Author: Harishchandra Patidar
+ *
+ * Created on 18 August, 2015, 1:00 PM
+ */
+
+#ifndef CONFERENCE_H
+#define	CONFERENCE_H
+
+#include<iostream>
+using namespace std;
+
+#include "Track.h"
+
+class ScheduleConstraints;
+
+class Conference {
+private:
+    // The array of tracks.
+    Track *tracks;
+
+    // The number of parallel tracks.
+    int parallelTracks;
+
+    // The number of sessions in a track.
+    int sessionsInTrack;
+
+    // The number of papers in a session.
+    int papersInSession;
+
+    // score of the conference
+    double score;
+
+    // The slot of every paper, indexed by paper id (-1 if not placed).
+    int *paperLocations;
+
+    // Hashes of the sessions, indexed by trackIndex * sessionsInTrack + sessionIndex,
+    // of the time slots and of the conference, see ZobristHash.
+    unsigned long long *sessionHashes;
+    unsigned long long *slotHashes;
+    unsigned long long hash;
+
+    // The constraints whose partners are counted (NULL if none) and, for every
+    // constrained paper, its conflicting partners in every time slot followed by
+    // its apart partners less its conflicting partners in every session.
+    ScheduleConstraints *constraints;
+    int *constraintCounts;
+
+    /**
+     * Copy the paper locations, hashes and constraint counts of another conference of the same shape.
+     */
+    void copyIndexes(const Conference &anotherConference);
+
+    /**
+     * Add a change to the counts of the partners of a paper placed in a session.
+     */
+    void countPartners(int paperId, int trackIndex, int sessionIndex, int change);
+
+public:
+    Conference();
+    ~Conference();
+    
+    /**
+     * Constructor for Conference.
+     * 
+     * @param parallelTracks is the number of parallel tracks.
+     * @param sessionsInTrack is the number of sessions in a track.
+     * @param papersInSession is the number of papers in a session.
+     */
+    Conference(int parallelTracks, int sessionsInTrack, int papersInSession);
+
+    /**
+     * Copy Constructor
+     */
+    Conference(const Conference& anotherConference);
+
+    /**
+     * Assignment Operator
+     */
+    Conference & operator=(const Conference &anotherConference);
+
+    /**
+     * Less than Operator
+     */
+    bool operator < (const Conference &rhs);
+    
+    
+    /**
+     * Initialize the tracks.
+     * @param parallelTracks is the number of parallel tracks.
+     * @param sessionsInTrack is the number of sessions in a track.
+     * @param papersInSession is the number of papers in a session.
+     */
+    void initTracks(int parallelTracks, int sessionsInTrack, int papersInSession);
+    
+    
+    /**
+     * returns the number of parallel tracks.
+     * @return the number of parallel tracks.
+     */
+    int getParallelTracks();
+    
+    
+    /**
+     * returns the number of sessions in a track.
+     * @return the number of sessions in a track.
+     */
+    int getSessionsInTrack();
+    
+    
+    /**
+     * returns the number of papers in a session.
+     * @return the number of papers in a session.
+     */
+    int getPapersInSession();
+
+    /**
+     * returns the score of the conference
+     * @return the score of the conference
+     */
+    double getScore();
+
+    /**
+     * increase the score of conference
+     * @param deltaScore value to be added to score
+     */
+    void increaseScore(double deltaScore);
+    
+    
+    /**
+     * Gets the track at the specified index.
+     * @param trackIndex the index of the specified track.
+     * @return the track
+     */
+    Track* getTrack(int trackIndex);
+
+    /**
+     * Gets the session specified by indexes
+     * @param trackIndex the index of the track
+     * @param sessionIndex the index of the specified session
+     * @return the session
+     */
+    Session* getSession(int trackIndex, int sessionIndex);
+
+    /**
+     * Gets the paper specified by indexes
+     * @param trackIndex the index of the track
+     * @param sessionIndex the index of the session
+     * @param paperIndex the index of the specified paper
+     * @return the paper
+     */
+    int getPaper(int trackIndex, int sessionIndex, int paperIndex);
+    
+    
+    /**
+     * Sets the paper in the specified slot to the given paper id.
+     * @param trackIndex the index of the track
+     * @param sessionIndex the index of the session
+     * @param paperIndex the index of the paper
+     * @param paperId the id of the paper.
+     */
+    void setPaper(int trackIndex, int sessionIndex, int paperIndex, int paperId);
+
+    /**
+     * Gets the slot of the given paper.
+     * @param paperId the id of the paper
+     * @param trackIndex set to the index of the track
+     * @param sessionIndex set to the index of the session
+     * @param paperIndex set to the index of the paper in the session
+     * @return false if the paper is not placed in the conference
+     */
+    bool getPaperLocation(int paperId, int &trackIndex, int &sessionIndex, int &paperIndex);
+
+    /**
+     * returns the hash of the conference, which does not depend on the order
+     * of papers in a session, of tracks or of time slots
+     * @return the hash of the conference
+     */
+    unsigned long long getHash();
+
+    /**
+     * Hash the conference would have after swapping two papers, in O(1)
+     * @param indexes specifying the papers to be swapped
+     * @return the hash after the swap
+     */
+    unsigned long long getHashAfterSwap(int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
+
+    /**
+     * Count where the partners of every constrained paper are, so that the
+     * constraints a paper would break in a session are found in O(1). The
+     * counts are kept up to date by setPaper and copied with the conference.
+     * @param constraints the constraints, NULL to stop counting
+     */
+    void setConstraints(ScheduleConstraints *constraints);
+
+    /**
+     * returns the constraints whose partners are counted
+     * @return the constraints, NULL if none
+     */
+    ScheduleConstraints* getConstraints();
+
+    /**
+     * returns the number of constraints a paper would break in a session,
+     * with its partners where they are now
+     * @param paperId the id of a constrained paper
+     * @param trackIndex the index of the track
+     * @param sessionIndex the index of the session
+     * @return the number of partners in the way
+     */
+    int getBrokenConstraints(int paperId, int trackIndex, int sessionIndex);
+    
+    /**
+     * Prints the conference
+     */
+    void printConference();
+};
+
+#endif	/* CONFERENCE_H */
+
@@ -0,0 +1,163 @@
+/*
+ * File:   ExactSolver.h
+ *
+ */
+
+#ifndef EXACTSOLVER_H
+#define	EXACTSOLVER_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <time.h>
+
+#include "Conference.h"
+
+using namespace std;
+
+/**
+ * ExactSolver finds a provably optimal organization of a small conference by
+ * branch and bound, placing the papers one at a time.
+ *
+ * Time slots, tracks within a time slot and papers within a session are
+ * interchangeable, so each paper either joins an open session, opens the next
+ * session of an open time slot or opens the next time slot. Every partition of
+ * the papers is then visited exactly once. The distance matrix must be symmetric.
+ */
+class ExactSolver {
+private:
+    /**
+     * A partial organization: the papers before the current depth are placed.
+     * Sessions are numbered timeSlot * parallelTracks + index in the time slot.
+     */
+    struct SearchState {
+        vector<int> sessionOfPaper;
+        vector<int> papersInOpenSession;
+        vector<int> sessionsOpenInSlot;
+        vector<int> papersInSlot;
+        int slotsOpen;
+        double score;
+
+        // distance of each paper to the placed papers of each session and time slot
+        vector<double> sessionDistance;
+        vector<double> slotDistance;
+    };
+
+    // the papers in the order they are placed, and their distances in that order
+    vector<int> paperOrder;
+    vector<double> distances;
+
+    int parallelTracks;
+    int sessionsInTrack;
+    int papersInSession;
+    double tradeoffCoefficient;
+
+    int numberOfPapers;
+    int numberOfSessions;
+
+    // largest scores of the pairs of a paper with the other unplaced papers,
+    // as prefix sums over the number of pairs, indexed [depth][paper]; the
+    // tables of a depth are built the first time a search reaches it
+    vector< vector< vector<double> > > largestSimilarities;
+    vector< vector< vector<double> > > largestParallels;
+    vector< vector< vector<double> > > largestPairs;
+    vector< atomic<bool> > boundsBuilt;
+    mutex boundsMutex;
+
+    atomic<double> bestScore;
+    vector<int> bestSessionOfPaper;
+    mutex bestMutex;
+
+    time_t deadline;
+    atomic<bool> timeUp;
+    atomic<long long> numberOfNodes;
+
+    /**
+     * Choose the order in which papers are placed.
+     * @param distanceMatrix is the distance matrix of the papers
+     */
+    void orderPapers(double **distanceMatrix);
+
+    /**
+     * Build the bounds on the pairs among the papers from depth on, unless
+     * another search has built them already.
+     */
+    void computePairBounds(int depth);
+
+    /**
+     * Initialize an empty search state.
+     */
+    void initState(SearchState &state);
+
+    /**
+     * Gains of the sessions the paper at depth may go to.
+     * @param state the partial organization
+     * @param depth the paper to be placed
+     * @param sessions receives the sessions
+     * @param gains receives the gain in score for each session
+     */
+    void getPlacements(SearchState &state, int depth, vector<int> &sessions, vector<double> &gains);
+
+    /**
+     * Place the paper at depth in a session, or take it out again.
+     */
+    void placePaper(SearchState &state, int depth, int session, double gain);
+    void removePaper(SearchState &state, int depth, int session, double gain);
+
+    /**
+     * Upper bound on the score of the pairs of a paper with the other unplaced
+     * papers, given how many session and parallel mates it has left.
+     */
+    double getPairBound(int depth, int paper, int sessionMates, int parallelMates);
+
+    /**
+     * Upper bound on the score of any completion of the partial organization.
+     */
+    double getUpperBound(SearchState &state, int depth);
+
+    /**
+     * Depth first search below the partial organization.
+     */
+    void search(SearchState &state, int depth, long long &nodesSinceCheck);
+
+    /**
+     * Collect the partial organizations at the target depth, as the sessions
+     * of their papers, to be searched in parallel.
+     */
+    void collectSubtrees(SearchState &state, int depth, int targetDepth, vector< vector<int> > &subtrees);
+
+    /**
+     * Search the subtrees taken from a shared counter until none are left.
+     */
+    void searchSubtrees(vector< vector<int> > *subtrees, atomic<int> *nextSubtree);
+
+public:
+    /**
+     * Constructor for ExactSolver.
+     *
+     * @param distanceMatrix is the symmetric distance matrix of the papers.
+     * @param parallelTracks is the number of parallel tracks.
+     * @param sessionsInTrack is the number of sessions in a track.
+     * @param papersInSession is the number of papers in a session.
+     * @param tradeoffCoefficient is the tradeoff coefficient.
+     */
+    ExactSolver(double **distanceMatrix, int parallelTracks, int sessionsInTrack, int papersInSession, double tradeoffCoefficient);
+
+    /**
+     * Search for an optimal organization.
+     * @param conference holds the starting organization, whose score is used
+     *        for pruning, and receives the best organization found
+     * @param timeLimitInSeconds the time after which the search gives up
+     * @return true if the organization is proven optimal
+     */
+    bool solve(Conference &conference, double timeLimitInSeconds);
+
+    /**
+     * returns the number of nodes visited by the last search
+     * @return the number of nodes
+     */
+    long long getNumberOfNodes();
+};
+
+#endif	/* EXACTSOLVER_H */
+
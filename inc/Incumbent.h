@@ -0,0 +1,132 @@
+/*
+ * File:   Incumbent.h
+ *
+ */
+
+#ifndef INCUMBENT_H
+#define	INCUMBENT_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Incumbent holds the best schedule found by the threads of a search, for
+ * the threads to improve on without locks. The best score is an atomic that
+ * a thread reads before offering anything, so nearly every offer is turned
+ * away by a single load. An offer that beats it takes the score with a
+ * compare and swap and then writes its schedule into a snapshot guarded by
+ * a sequence lock, so readers never block the search. The snapshot is held
+ * in relaxed atomics, so a reader racing a writer reads torn values that it
+ * throws away, rather than racing on plain memory.
+ *
+ * Schedules are arrays of paper ids in the layout of Conference. A listener,
+ * such as the writer of the output file, is told of new schedules by the
+ * threads that offer them, one call at a time.
+ */
+class Incumbent {
+private:
+    // the best score offered, read by the threads on every iteration
+    atomic<double> bestScore;
+
+    // the snapshot of the best schedule, odd sequence numbers while it is written
+    atomic<unsigned long long> sequence;
+    atomic<int> *papers;
+    int numberOfPapers;
+    atomic<double> snapshotScore;
+    atomic<long long> version;
+
+    // called with every new snapshot, and the version it was last called for
+    function<void(const vector<int>&, double)> listener;
+    mutex listenerMutex;
+    atomic<long long> notifiedVersion;
+
+    /**
+     * Take the sequence lock of the snapshot.
+     * @return the even sequence number the lock was taken at
+     */
+    unsigned long long lockSnapshot();
+
+    /**
+     * Write a schedule into the snapshot.
+     * @param onlyIfBetter leave the snapshot alone unless the score beats its own
+     */
+    void writeSnapshot(const vector<int> &papers, double score, bool onlyIfBetter);
+
+    /**
+     * Call the listener until it has seen the latest snapshot, unless another
+     * thread is calling it, which then calls it again if needed.
+     */
+    void notifyListener();
+
+    // the snapshot is shared by the threads, copying is not allowed
+    Incumbent(const Incumbent &another);
+    Incumbent & operator=(const Incumbent &another);
+
+public:
+    Incumbent();
+    ~Incumbent();
+
+    /**
+     * Start from a schedule, without calling the listener. Not to be called
+     * while other threads use the incumbent.
+     *
+     * @param papers is the schedule in the layout of Conference.
+     * @param score is its score.
+     */
+    void init(const vector<int> &papers, double score);
+
+    /**
+     * Set the function told of every new best schedule. It is called by the
+     * threads making the offers, never by two at the same time.
+     */
+    void setListener(function<void(const vector<int>&, double)> listener);
+
+    /**
+     * returns the best score offered
+     * @return the score, without taking any lock
+     */
+    double getScore()
+    {
+        return bestScore.load(memory_order_relaxed);
+    }
+
+    /**
+     * Offer a schedule, taken if its score beats the best score.
+     *
+     * @param papers is the schedule in the layout of Conference.
+     * @param score is its score.
+     * @return true if the schedule became the incumbent
+     */
+    bool offer(const vector<int> &papers, double score);
+
+    /**
+     * Read the best schedule.
+     *
+     * @param papers receives the schedule in the layout of Conference.
+     * @param score receives its score.
+     * @return the number of schedules taken so far
+     */
+    long long read(vector<int> &papers, double &score);
+
+    /**
+     * returns the number of schedules taken so far
+     * @return the version of the snapshot
+     */
+    long long getVersion();
+
+    /**
+     * Replace the score of the best schedule by one computed again from
+     * scratch, unless the snapshot holds another schedule by now.
+     *
+     * @param papers is the schedule in the layout of Conference.
+     * @param score is its corrected score.
+     */
+    void correctScore(const vector<int> &papers, double score);
+};
+
+#endif	/* INCUMBENT_H */
+
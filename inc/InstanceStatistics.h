@@ -0,0 +1,125 @@
+/*
+ * File:   InstanceStatistics.h
+ *
+ */
+
+#ifndef INSTANCESTATISTICS_H
+#define	INSTANCESTATISTICS_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * InstanceStatistics holds what is learned about the distance matrix while
+ * it is parsed: the sum, smallest and largest distance of every row, whether
+ * the matrix is symmetric and the finest units all distances are a whole
+ * number of. Rows are added by the parsing threads right after they are
+ * parsed, in any order, so the matrix is not walked again afterwards.
+ *
+ * Symmetry is checked by hashing every row and every column of the matrix
+ * into a number that does not depend on the order of the entries: the
+ * matrix is symmetric when row i and column i hash alike for every i.
+ * Columns are hashed by each thread on its own, and merged by finish.
+ */
+class InstanceStatistics {
+private:
+    int numberOfPapers;
+    bool valid;
+    bool symmetric;
+    int quantizationScale;
+
+    vector<double> rowSums;
+    vector<double> rowMinimums;
+    vector<double> rowMaximums;
+
+    // whether every distance of a row is a whole number of 1/100 up to 2.55,
+    // or of 1/10000 up to 6.5535
+    vector<char> rowFits8Bits;
+    vector<char> rowFits16Bits;
+
+    // hashes of the rows, and of the columns as seen by each thread
+    vector<unsigned long long> rowHashes;
+    vector< vector<unsigned long long> > columnHashes;
+
+    /**
+     * Hash of a distance at a position of its row or column.
+     */
+    static unsigned long long hashEntry(double distance, int position);
+
+public:
+    InstanceStatistics();
+
+    /**
+     * Start collecting the statistics of a matrix.
+     *
+     * @param numberOfPapers is the number of papers.
+     * @param numberOfThreads is the number of threads adding rows.
+     */
+    void init(int numberOfPapers, int numberOfThreads);
+
+    /**
+     * Add a row of the distance matrix. Every row is added exactly once, by
+     * any of the threads, and no thread adds rows at the same time as another
+     * thread of the same number.
+     *
+     * @param distances the row of distances
+     * @param paperId the id of the paper of the row
+     * @param thread the number of the adding thread, below numberOfThreads
+     */
+    void addRow(const double *distances, int paperId, int thread);
+
+    /**
+     * Combine what the threads found once every row is added.
+     */
+    void finish();
+
+    /**
+     * Forget the statistics, after the distances change.
+     */
+    void clear();
+
+    /**
+     * returns whether the statistics describe the current distances
+     * @return true if finished and not cleared since
+     */
+    bool isValid();
+
+    /**
+     * returns whether the distance matrix is symmetric
+     * @return true if every distance equals its transposed distance
+     */
+    bool isSymmetric();
+
+    /**
+     * returns the finest units every distance is a whole number of
+     * @return 100 if the distances fit 8 bit units, 10000 if they fit 16 bit
+     *         units, 0 if they fit neither
+     */
+    int getQuantizationScale();
+
+    /**
+     * returns the sum of the distances of a paper to every paper
+     * @param paperId the id of the paper
+     * @return the sum of its row
+     */
+    double getRowSum(int paperId);
+
+    /**
+     * returns the smallest and largest distance of a paper to another paper
+     * @param paperId the id of the paper
+     * @return the smallest or largest distance of its row, apart from itself
+     */
+    double getMinimumDistance(int paperId);
+    double getMaximumDistance(int paperId);
+
+    /**
+     * returns the smallest and largest distance between two papers
+     * @return the smallest or largest distance of the matrix, apart from the diagonal
+     */
+    double getMinimumDistance();
+    double getMaximumDistance();
+};
+
+#endif	/* INSTANCESTATISTICS_H */
+
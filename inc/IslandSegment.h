@@ -0,0 +1,152 @@
+/*
+ * File:   IslandSegment.h
+ *
+ */
+
+#ifndef ISLANDSEGMENT_H
+#define	ISLANDSEGMENT_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include <sys/stat.h>
+
+using namespace std;
+
+// the layout of the shared memory, defined with the segment
+struct IslandSegmentHeader;
+
+/**
+ * IslandSegment is a POSIX shared memory segment through which solver
+ * processes on one host cooperate as islands. It holds the distance matrix,
+ * read once by the process creating the segment, the best schedule found by
+ * any island, and a ring of elite schedules migrating between the islands.
+ *
+ * Schedules are arrays of paper ids in the layout of Conference, guarded by
+ * sequence locks so that readers never block writers. The lock of an island
+ * killed while writing is taken over by the next writer.
+ */
+class IslandSegment {
+private:
+    string name;
+    IslandSegmentHeader *segment;
+    size_t size;
+    bool created;
+
+    /**
+     * Create the segment, or map the one of the same name.
+     * @param stale set if the segment found was left behind and is removed
+     * @return true if attached
+     */
+    bool open(const struct stat &fileStatus, int numberOfPapers, double tradeoffCoefficient, bool &stale);
+
+    /**
+     * Record this process among the islands of the segment.
+     * @return false if every entry is taken by a running island
+     */
+    bool addIsland();
+
+    /**
+     * Count the islands that are running, freeing the entries of the others.
+     */
+    int countIslands();
+
+    /**
+     * Write a schedule into a slot of the segment.
+     * @param slot the index of the slot, -1 for the incumbent
+     * @param onlyIfBetter leave the slot alone unless the score beats the slot's
+     * @return true if the schedule was written
+     */
+    bool writeSlot(int slot, const vector<int> &papers, double score, bool onlyIfBetter);
+
+    /**
+     * Read the schedule in a slot of the segment.
+     * @return false if the slot is empty, was written by this process or
+     *         could not be read consistently
+     */
+    bool readSlot(int slot, vector<int> &papers, double &score);
+
+    // the segment is unmapped once, copying is not allowed
+    IslandSegment(const IslandSegment &another);
+    IslandSegment & operator=(const IslandSegment &another);
+
+public:
+    IslandSegment();
+    ~IslandSegment();
+
+    /**
+     * Attach to the segment of the given name, creating it if no island has.
+     * A segment created for another input file is not used.
+     *
+     * @param name is the name of the island model.
+     * @param inputFileName is the input file, identifying the instance.
+     * @param numberOfPapers is the number of papers.
+     * @param tradeoffCoefficient is the tradeoff coefficient.
+     * @return true if attached
+     */
+    bool attach(string name, string inputFileName, int numberOfPapers, double tradeoffCoefficient);
+
+    /**
+     * Detach from the segment, removing it if this was the last island.
+     */
+    void detach();
+
+    /**
+     * returns true if attached to a segment
+     */
+    bool isAttached();
+
+    /**
+     * returns true if this process created the segment and must fill in the matrix
+     */
+    bool isCreator();
+
+    /**
+     * Wait until the creator has filled in the matrix, for as long as it runs.
+     * @return false if the creator died first
+     */
+    bool waitUntilReady();
+
+    /**
+     * Tell the other islands that the matrix is filled in.
+     */
+    void setReady();
+
+    /**
+     * Gets the row major distance matrix held by the segment.
+     */
+    double* getDistances();
+
+    /**
+     * returns the number of islands attached and running
+     */
+    int getNumberOfIslands();
+
+    /**
+     * Publish a schedule as the best of all islands if it beats the current one.
+     * @param papers the schedule
+     * @param score its score
+     * @return true if it became the best
+     */
+    bool publishIncumbent(const vector<int> &papers, double score);
+
+    /**
+     * Read the best schedule of all islands, unless this process published it.
+     * @return true if a schedule of another island was read
+     */
+    bool readIncumbent(vector<int> &papers, double &score);
+
+    /**
+     * Publish a schedule to the ring of migrating elites, over the oldest one.
+     */
+    void publishElite(const vector<int> &papers, double score);
+
+    /**
+     * Read a random elite published by another island.
+     * @return true if one was read
+     */
+    bool readElite(mt19937 &generator, vector<int> &papers, double &score);
+};
+
+#endif	/* ISLANDSEGMENT_H */
+
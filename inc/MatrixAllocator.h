@@ -0,0 +1,72 @@
+/*
+ * File:   MatrixAllocator.h
+ *
+ */
+
+#ifndef MATRIXALLOCATOR_H
+#define	MATRIXALLOCATOR_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * MatrixAllocator allocates the large blocks holding the distance matrix with
+ * a chosen page size and NUMA placement, to cut the TLB misses and remote
+ * memory accesses of the random row reads of the scoring functions.
+ */
+class MatrixAllocator {
+public:
+    enum Policy {
+        DEFAULT_PAGES,              // ordinary pages, placed on first touch
+        TRANSPARENT_HUGE_PAGES,     // ordinary mapping advised to use huge pages
+        EXPLICIT_HUGE_PAGES,        // pages from the huge page pool, else transparent
+        INTERLEAVED_NODES,          // huge pages spread evenly over the NUMA nodes
+        REPLICATED_NODES            // a copy of the matrix on every NUMA node
+    };
+
+    /**
+     * Parse the name of a policy: "default", "thp", "hugetlb", "interleave"
+     * or "replicate".
+     * @param name the name of the policy
+     * @param policy receives the policy
+     * @return false if the name is unknown
+     */
+    static bool parsePolicy(string name, Policy &policy);
+
+    /**
+     * returns the name of a policy
+     */
+    static const char* getPolicyName(Policy policy);
+
+    /**
+     * Allocate a zero filled block.
+     * @param size the size of the block in bytes
+     * @param policy the page size and placement of the block
+     * @param node the NUMA node to bind the block to, -1 for the policy's placement
+     * @return the block, or NULL if no memory is left
+     */
+    static void* allocate(size_t size, Policy policy, int node = -1);
+
+    /**
+     * Free a block returned by allocate.
+     * @param block the block
+     * @param size the size given to allocate
+     * @param policy the policy given to allocate
+     */
+    static void release(void *block, size_t size, Policy policy);
+
+    /**
+     * returns the number of NUMA nodes of the machine, at least 1
+     */
+    static int getNumberOfNodes();
+
+    /**
+     * returns the NUMA node the calling thread first ran on, looked up once per thread
+     */
+    static int getCurrentNode();
+};
+
+#endif	/* MATRIXALLOCATOR_H */
+
@@ -0,0 +1,47 @@
+/*
+ * File:   MoveSampler.h
+ *
+ */
+
+#ifndef MOVESAMPLER_H
+#define	MOVESAMPLER_H
+
+/**
+ * MoveSampler chooses the kind of the next local search move so that every
+ * kind gets its share of the time spent evaluating moves. Expensive moves are
+ * then sampled less often and do not slow the search down.
+ */
+class MoveSampler {
+public:
+    enum MoveType { SWAP_MOVE, ROTATION_MOVE, EJECTION_CHAIN_MOVE, NUMBER_OF_MOVE_TYPES };
+
+private:
+    double shares[NUMBER_OF_MOVE_TYPES];
+    double spentSeconds[NUMBER_OF_MOVE_TYPES];
+
+public:
+    /**
+     * Constructor for MoveSampler.
+     *
+     * @param swapShare is the share of time for swaps of two papers.
+     * @param rotationShare is the share of time for rotations of three papers.
+     * @param ejectionChainShare is the share of time for ejection chains.
+     */
+    MoveSampler(double swapShare, double rotationShare, double ejectionChainShare);
+
+    /**
+     * Choose the kind of move furthest below its share of the time.
+     * @return the kind of the next move
+     */
+    MoveType nextMove();
+
+    /**
+     * Record the time spent on a move.
+     * @param move the kind of the move
+     * @param seconds the time spent on it
+     */
+    void recordMove(MoveType move, double seconds);
+};
+
+#endif	/* MOVESAMPLER_H */
+
@@ -0,0 +1,81 @@
+/*
+ * File:   OperatorBandit.h
+ *
+ */
+
+#ifndef OPERATORBANDIT_H
+#define	OPERATORBANDIT_H
+
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+/**
+ * OperatorBandit chooses the next local search operator by a sliding window
+ * upper confidence bound. The reward of an operator is the score it gained
+ * per microsecond of CPU time, so cheap operators that still improve are
+ * preferred, and the window lets the choice follow the search as the
+ * improving operators change from the start to the end of a run.
+ */
+class OperatorBandit {
+private:
+    int numberOfOperators;
+    int windowSize;
+    double exploration;
+
+    // the operators played in the window, oldest first, and their rewards
+    deque<int> playedOperators;
+    deque<double> rewards;
+
+    // number of plays and sum of rewards of each operator within the window
+    vector<int> plays;
+    vector<double> rewardSums;
+
+    // plays and score gained by each operator over the whole run
+    vector<long long> totalPlays;
+    vector<double> totalGains;
+    vector<double> totalMicroseconds;
+
+public:
+    /**
+     * Constructor for OperatorBandit.
+     *
+     * @param numberOfOperators is the number of operators to choose from.
+     * @param windowSize is the number of last plays the rewards are taken from.
+     * @param exploration is the weight of the confidence term.
+     */
+    OperatorBandit(int numberOfOperators, int windowSize, double exploration);
+
+    /**
+     * Choose the operator with the largest upper confidence bound. Operators
+     * not played within the window are tried first.
+     * @return the index of the next operator
+     */
+    int nextOperator();
+
+    /**
+     * Record the outcome of a play.
+     * @param op the operator played
+     * @param gain the increase in score, zero if it failed
+     * @param microseconds the CPU time spent on it
+     */
+    void recordOperator(int op, double gain, double microseconds);
+
+    /**
+     * returns the number of times an operator was played over the run
+     * @param op the operator
+     * @return the number of plays
+     */
+    long long getTotalPlays(int op);
+
+    /**
+     * returns the score gained per microsecond by an operator over the run
+     * @param op the operator
+     * @return the gain per microsecond
+     */
+    double getGainRate(int op);
+};
+
+#endif	/* OPERATORBANDIT_H */
+
@@ -0,0 +1,153 @@
+/*
+ * File:   QuantizedDistanceMatrix.h
+ *
+ */
+
+#ifndef QUANTIZEDDISTANCEMATRIX_H
+#define	QUANTIZEDDISTANCEMATRIX_H
+
+#include <vector>
+
+#include "MatrixAllocator.h"
+#include "SessionKernels.h"
+
+using namespace std;
+
+/**
+ * QuantizedDistanceMatrix keeps the distances as fixed point integers, in 8
+ * bits with 100 units per 1.0 when every distance fits, otherwise in 16 bits
+ * with 10000 units per 1.0. Sums over sessions are accumulated in integers
+ * and are exact.
+ */
+class QuantizedDistanceMatrix {
+private:
+    int numberOfPapers;
+    int scale;      // units per 1.0 of distance, 0 if not built
+    int bits;       // bits of every distance
+
+    // row major distances, one copy for every NUMA node when replicated
+    vector<void*> copies;
+    size_t size;
+    MatrixAllocator::Policy policy;
+
+    /**
+     * Check that every distance is a whole number of units that fits the maximum.
+     */
+    bool fits(double **distanceMatrix, int numberOfPapers, int scale, int maximum);
+
+    /**
+     * Gets the copy of the distances on the NUMA node of the calling thread.
+     */
+    const void* getLocalCopy()
+    {
+        return copies.size() == 1 ? copies[0] : copies[MatrixAllocator::getCurrentNode() % copies.size()];
+    }
+
+    // kernels summing the distances of sessions, for each storage
+    SessionKernels< QuantizedRows<unsigned char> > kernels8;
+    SessionKernels< QuantizedRows<unsigned short> > kernels16;
+
+    // the copies are not shared, copying is not allowed
+    QuantizedDistanceMatrix(const QuantizedDistanceMatrix &another);
+    QuantizedDistanceMatrix & operator=(const QuantizedDistanceMatrix &another);
+
+public:
+    QuantizedDistanceMatrix();
+    ~QuantizedDistanceMatrix();
+
+    /**
+     * Quantize the distance matrix.
+     *
+     * @param distanceMatrix is the distance matrix of the papers.
+     * @param numberOfPapers is the number of papers.
+     * @param policy is the page size and placement of the distances.
+     * @return false if some distance is negative, too large or not a whole
+     *         number of 1/10000, the matrix is then left unbuilt
+     */
+    bool build(double **distanceMatrix, int numberOfPapers, MatrixAllocator::Policy policy = MatrixAllocator::DEFAULT_PAGES);
+
+    /**
+     * Quantize the distance matrix, with the units already known from a scan
+     * of the distances.
+     *
+     * @param distanceMatrix is the distance matrix of the papers.
+     * @param numberOfPapers is the number of papers.
+     * @param policy is the page size and placement of the distances.
+     * @param scale is 100 or 10000 units per 1.0, 0 if the distances fit neither.
+     * @return false if the scale is 0, the matrix is then left unbuilt
+     */
+    bool build(double **distanceMatrix, int numberOfPapers, MatrixAllocator::Policy policy, int scale);
+
+    /**
+     * Choose the kernels of the session sums for a number of papers in a session.
+     * @param papersInSession the number of papers in every session
+     */
+    void selectKernels(int papersInSession);
+
+    /**
+     * Free the distances, leaving the matrix unbuilt.
+     */
+    void clear();
+
+    /**
+     * returns the units per 1.0 of distance
+     * @return the scale, 0 if the matrix is not built
+     */
+    int getScale();
+
+    /**
+     * returns the bits used for every distance
+     * @return 8 or 16, 0 if the matrix is not built
+     */
+    int getBits();
+
+    /**
+     * Gets the row major distances of getBits() bits on the NUMA node of the
+     * calling thread. Four bytes may be read at any distance.
+     */
+    const void* getDistances()
+    {
+        return getLocalCopy();
+    }
+
+    /**
+     * Get a distance in units.
+     */
+    int getDistance(int paper1, int paper2)
+    {
+        size_t index = (size_t)paper1 * numberOfPapers + paper2;
+        const void *distances = getLocalCopy();
+        return bits == 8 ? ((const unsigned char*)distances)[index] : ((const unsigned short*)distances)[index];
+    }
+
+    /**
+     * Check that a distance is a whole number of units that fits the storage.
+     * @return false if setting it would round or clamp it
+     */
+    bool canHold(double distance);
+
+    /**
+     * Set a distance, rounded to the nearest unit and clamped to the storage.
+     * @return the distance stored, in units
+     */
+    int setDistance(int paper1, int paper2, double distance);
+
+    /**
+     * Sum of (scale - distance) over the pairs of a session, each pair read
+     * with the earlier paper first.
+     * @param papers the papers of the session
+     * @param numberOfPapers the number of papers
+     * @return the sum in units
+     */
+    long long getSimilarityUnits(const int *papers, int numberOfPapers);
+
+    /**
+     * Sum of the distances from every paper of one session to every paper of
+     * another.
+     * @return the sum in units
+     */
+    long long getParallelUnits(const int *papers1, int numberOfPapers1, const int *papers2, int numberOfPapers2);
+};
+
+#endif	/* QUANTIZEDDISTANCEMATRIX_H */
+
@@ -0,0 +1,178 @@
+/*
+ * File:   ScheduleConstraints.h
+ *
+ */
+
+#ifndef SCHEDULECONSTRAINTS_H
+#define	SCHEDULECONSTRAINTS_H
+
+#include <vector>
+#include <unordered_set>
+
+using namespace std;
+
+/**
+ * ScheduleConstraints holds the hard constraints of a conference, compiled
+ * per paper: a mask of the time slots the paper may be placed in, the papers
+ * it must not run in parallel with (author conflicts) and the papers it must
+ * not share a session with. Papers without constraints are flagged, so a move
+ * of unconstrained papers is checked with a single lookup each. Constrained
+ * papers are numbered in the order they got their first constraint, and the
+ * pairs of papers are kept in sets, so that Conference can count where the
+ * partners of every constrained paper are.
+ */
+class ScheduleConstraints {
+private:
+    int numberOfPapers;
+    int sessionsInTrack;
+    int wordsPerPaper;
+    int numberOfConstraints;
+
+    // whether a paper has any constraint, the papers that do, and the index
+    // of every paper among them, -1 for the others
+    vector<char> constrained;
+    vector<int> constrainedPapers;
+    vector<int> constrainedIndexes;
+
+    // the time slots each paper may take, wordsPerPaper words per paper
+    vector<unsigned long long> slotMasks;
+    vector<bool> pinned;
+
+    // the papers each paper must not run in parallel with, or share a session with
+    vector< vector<int> > conflicts;
+    vector< vector<int> > apart;
+
+    // the same pairs both ways round, see getPairKey
+    unordered_set<unsigned long long> conflictPairs;
+    unordered_set<unsigned long long> apartPairs;
+
+    /**
+     * Flag a paper as constrained.
+     */
+    void markConstrained(int paperId);
+
+    /**
+     * Key of an ordered pair of papers in the sets of pairs.
+     */
+    inline unsigned long long getPairKey(int paper1, int paper2)
+    {
+        return (unsigned long long)paper1 * numberOfPapers + paper2;
+    }
+
+public:
+    ScheduleConstraints();
+
+    /**
+     * Start without constraints for a conference of the given size.
+     *
+     * @param numberOfPapers is the number of papers.
+     * @param sessionsInTrack is the number of time slots.
+     */
+    void init(int numberOfPapers, int sessionsInTrack);
+
+    /**
+     * The two papers must not be in the same time slot in different tracks.
+     * A pair given twice is kept once.
+     * @return false if a paper is out of range or the papers are the same
+     */
+    bool addConflict(int paper1, int paper2);
+
+    /**
+     * The paper may be placed in the time slot. A paper pinned to several
+     * time slots may take any of them.
+     * @return false if the paper or the time slot is out of range
+     */
+    bool addPin(int paperId, int sessionIndex);
+
+    /**
+     * The two papers must not be in the same session. A pair given twice is
+     * kept once.
+     * @return false if a paper is out of range or the papers are the same
+     */
+    bool addApart(int paper1, int paper2);
+
+    /**
+     * returns the number of constraints added
+     * @return the number of constraints
+     */
+    int getNumberOfConstraints();
+
+    /**
+     * returns the papers with at least one constraint
+     * @return the constrained papers
+     */
+    const vector<int>& getConstrainedPapers();
+
+    /**
+     * Whether any constraint was added.
+     */
+    inline bool hasConstraints()
+    {
+        return numberOfConstraints > 0;
+    }
+
+    /**
+     * Whether a paper has any constraint. Papers of empty slots have none.
+     */
+    inline bool isConstrained(int paperId)
+    {
+        return paperId >= 0 && paperId < (int)constrained.size() && constrained[paperId];
+    }
+
+    /**
+     * returns the index of a constrained paper among the constrained papers
+     * @param paperId the id of the paper
+     * @return the index, -1 if the paper has no constraint
+     */
+    inline int getConstrainedIndex(int paperId)
+    {
+        return constrainedIndexes[paperId];
+    }
+
+    /**
+     * Whether two papers must not run in parallel.
+     */
+    inline bool isConflict(int paper1, int paper2)
+    {
+        return conflictPairs.count(getPairKey(paper1, paper2)) > 0;
+    }
+
+    /**
+     * Whether two papers must not share a session.
+     */
+    inline bool isApart(int paper1, int paper2)
+    {
+        return apartPairs.count(getPairKey(paper1, paper2)) > 0;
+    }
+
+    /**
+     * Whether a paper may be placed in a time slot.
+     */
+    inline bool isSlotAllowed(int paperId, int sessionIndex)
+    {
+        return (slotMasks[(size_t)paperId * wordsPerPaper + sessionIndex / 64] >> (sessionIndex % 64)) & 1;
+    }
+
+    /**
+     * returns the papers a paper must not run in parallel with
+     * @param paperId the id of the paper
+     * @return the conflicting papers
+     */
+    inline const vector<int>& getConflicts(int paperId)
+    {
+        return conflicts[paperId];
+    }
+
+    /**
+     * returns the papers a paper must not share a session with
+     * @param paperId the id of the paper
+     * @return the papers kept apart from it
+     */
+    inline const vector<int>& getApart(int paperId)
+    {
+        return apart[paperId];
+    }
+};
+
+#endif	/* SCHEDULECONSTRAINTS_H */
+
@@ -0,0 +1,219 @@
+/*
+ * File:   SessionKernels.h
+ *
+ */
+
+#ifndef SESSIONKERNELS_H
+#define	SESSIONKERNELS_H
+
+#include <cstddef>
+
+using namespace std;
+
+// the largest number of papers in a session with kernels of its own
+#define SESSION_KERNEL_MAX_PAPERS 16
+
+/**
+ * Rows of the distance matrix as read, one pointer per paper.
+ */
+struct DoubleRows {
+    typedef double Distance;
+    typedef double Sum;
+
+    double **distanceMatrix;
+
+    DoubleRows(double **distanceMatrix) : distanceMatrix(distanceMatrix) {}
+
+    const double* getRow(int paperId) const
+    {
+        return distanceMatrix[paperId];
+    }
+};
+
+/**
+ * Rows of a fixed point distance matrix, kept in one row major block.
+ */
+template <typename T>
+struct QuantizedRows {
+    typedef T Distance;
+    typedef long long Sum;
+
+    const T *distances;
+    size_t numberOfPapers;
+
+    QuantizedRows(const T *distances, size_t numberOfPapers) : distances(distances), numberOfPapers(numberOfPapers) {}
+
+    const T* getRow(int paperId) const
+    {
+        return distances + (size_t)paperId * numberOfPapers;
+    }
+};
+
+/**
+ * SessionKernels sums the distances of the pairs of a session, and between
+ * the papers of two sessions, for one way of storing the rows. Sessions of 2
+ * to SESSION_KERNEL_MAX_PAPERS papers have kernels with the number of papers
+ * fixed at compile time, whose loops are fully unrolled and which keep one
+ * sum per row in registers; larger sessions use loops bounded at run time.
+ * The kernels are chosen once from a table by select, when the number of
+ * papers in a session is known.
+ */
+template <typename Rows>
+class SessionKernels {
+public:
+    typedef typename Rows::Distance Distance;
+    typedef typename Rows::Sum Sum;
+    typedef Sum (*PairKernel)(const Rows &rows, const int *papers, int numberOfPapers);
+    typedef Sum (*CrossKernel)(const Rows &rows, const int *papers1, const int *papers2, int numberOfPapers);
+
+private:
+    int papersInSession;
+    PairKernel pairKernel;
+    CrossKernel crossKernel;
+
+    /**
+     * Sum of the distances of the pairs of a session, each pair read from the
+     * row of its earlier paper, for any number of papers.
+     */
+    static Sum sumPairsOfAny(const Rows &rows, const int *papers, int numberOfPapers)
+    {
+        Sum sum = 0;
+        for(int i = 0; i < numberOfPapers; i++)
+        {
+            const Distance *row = rows.getRow(papers[i]);
+            for(int j = i + 1; j < numberOfPapers; j++)
+                sum += row[papers[j]];
+        }
+        return sum;
+    }
+
+    /**
+     * Sum of the distances from every paper of one session to every paper of
+     * another, for any numbers of papers.
+     */
+    static Sum sumCrossOfSizes(const Rows &rows, const int *papers1, int numberOfPapers1, const int *papers2, int numberOfPapers2)
+    {
+        Sum sum = 0;
+        for(int i = 0; i < numberOfPapers1; i++)
+        {
+            const Distance *row = rows.getRow(papers1[i]);
+            for(int j = 0; j < numberOfPapers2; j++)
+                sum += row[papers2[j]];
+        }
+        return sum;
+    }
+
+    static Sum sumCrossOfAny(const Rows &rows, const int *papers1, const int *papers2, int numberOfPapers)
+    {
+        return sumCrossOfSizes(rows, papers1, numberOfPapers, papers2, numberOfPapers);
+    }
+
+    /**
+     * The same sums for sessions of exactly K papers.
+     */
+    template <int K>
+    static Sum sumPairsOf(const Rows &rows, const int *papers, int /* numberOfPapers */)
+    {
+        int others[K];
+        Sum sums[K];
+#pragma GCC unroll 16
+        for(int i = 0; i < K; i++)
+            others[i] = papers[i];
+
+#pragma GCC unroll 16
+        for(int i = 0; i < K - 1; i++)
+        {
+            const Distance *row = rows.getRow(others[i]);
+            sums[i] = 0;
+#pragma GCC unroll 16
+            for(int j = i + 1; j < K; j++)
+                sums[i] += row[others[j]];
+        }
+
+        Sum sum = 0;
+#pragma GCC unroll 16
+        for(int i = 0; i < K - 1; i++)
+            sum += sums[i];
+        return sum;
+    }
+
+    template <int K>
+    static Sum sumCrossOf(const Rows &rows, const int *papers1, const int *papers2, int /* numberOfPapers */)
+    {
+        int others[K];
+        Sum sums[K];
+#pragma GCC unroll 16
+        for(int j = 0; j < K; j++)
+            others[j] = papers2[j];
+
+#pragma GCC unroll 16
+        for(int i = 0; i < K; i++)
+        {
+            const Distance *row = rows.getRow(papers1[i]);
+            sums[i] = 0;
+#pragma GCC unroll 16
+            for(int j = 0; j < K; j++)
+                sums[i] += row[others[j]];
+        }
+
+        Sum sum = 0;
+#pragma GCC unroll 16
+        for(int i = 0; i < K; i++)
+            sum += sums[i];
+        return sum;
+    }
+
+public:
+    SessionKernels()
+    {
+        select(0);
+    }
+
+    /**
+     * Choose the kernels for sessions of a number of papers.
+     * @param papersInSession the number of papers in every session
+     */
+    void select(int papersInSession)
+    {
+        static const PairKernel pairKernels[SESSION_KERNEL_MAX_PAPERS + 1] = {
+            sumPairsOfAny, sumPairsOfAny, sumPairsOf<2>, sumPairsOf<3>, sumPairsOf<4>, sumPairsOf<5>,
+            sumPairsOf<6>, sumPairsOf<7>, sumPairsOf<8>, sumPairsOf<9>, sumPairsOf<10>, sumPairsOf<11>,
+            sumPairsOf<12>, sumPairsOf<13>, sumPairsOf<14>, sumPairsOf<15>, sumPairsOf<16>
+        };
+        static const CrossKernel crossKernels[SESSION_KERNEL_MAX_PAPERS + 1] = {
+            sumCrossOfAny, sumCrossOfAny, sumCrossOf<2>, sumCrossOf<3>, sumCrossOf<4>, sumCrossOf<5>,
+            sumCrossOf<6>, sumCrossOf<7>, sumCrossOf<8>, sumCrossOf<9>, sumCrossOf<10>, sumCrossOf<11>,
+            sumCrossOf<12>, sumCrossOf<13>, sumCrossOf<14>, sumCrossOf<15>, sumCrossOf<16>
+        };
+
+        bool specialized = papersInSession >= 0 && papersInSession <= SESSION_KERNEL_MAX_PAPERS;
+        this->papersInSession = papersInSession;
+        pairKernel = specialized ? pairKernels[papersInSession] : sumPairsOfAny;
+        crossKernel = specialized ? crossKernels[papersInSession] : sumCrossOfAny;
+    }
+
+    /**
+     * Sum of the distances of the pairs of a session, each pair read from the
+     * row of its earlier paper.
+     */
+    Sum sumPairs(const Rows &rows, const int *papers, int numberOfPapers) const
+    {
+        if(numberOfPapers != papersInSession)
+            return sumPairsOfAny(rows, papers, numberOfPapers);
+        return pairKernel(rows, papers, numberOfPapers);
+    }
+
+    /**
+     * Sum of the distances from every paper of one session to every paper of
+     * another.
+     */
+    Sum sumCross(const Rows &rows, const int *papers1, int numberOfPapers1, const int *papers2, int numberOfPapers2) const
+    {
+        if(numberOfPapers1 != papersInSession || numberOfPapers2 != papersInSession)
+            return sumCrossOfSizes(rows, papers1, numberOfPapers1, papers2, numberOfPapers2);
+        return crossKernel(rows, papers1, papers2, numberOfPapers1);
+    }
+};
+
+#endif	/* SESSIONKERNELS_H */
+
@@ -1,179 +1,1044 @@
-/* 
- * File:   SessionOrganizer.h
- * Author: Harishchandra Patidar
- *
- */
-
-#ifndef SESSIONORGANIZER_H
-#define	SESSIONORGANIZER_H
-
-#include <string>
-#include <iostream>
-#include <fstream>
-#include <vector>
-#include <unistd.h>
-#include <time.h>
-
-
-#include "Conference.h"
-#include "Track.h"
-#include "Session.h"
-
-using namespace std;
-
-/**
- * SessionOrganizer reads in a similarity matrix of papers, and organizes them
- * into sessions and tracks.
- * 
- * @author Harishchandra Patidar
- *
- */
-class SessionOrganizer {
-private:
-    double **distanceMatrix;
-
-    int parallelTracks ;
-    int papersInSession ;
-    int sessionsInTrack ;
-
-    Conference *conference;
-
-    double processingTimeInMinutes ;
-    double tradeoffCoefficient ; // the tradeoff coefficient
-
-    time_t starting_time;
-    string outputFileName;
-
-    double globalMaximumScore;
-
-    /**
-     * Read in the number of parallel tracks, papers in session, sessions
-     * in a track, and the similarity matrix from the specified filename.
-     * @param filename is the name of the file containing the matrix.
-     */
-    void readInInputFile(string filename);
-
-    /*
-     * Organize the papers Initially
-     */
-    void initializeOrganization(Conference *conference);
-
-
-    /*
-     * Greedily Organize the papers Initially
-     */
-
-    void initializeGreedyOrganization();
-
-    /**
-     * swap two papers in the conference
-     * @param indexes specifying the papers to be swapped
-     */
-    void swapPapers(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
-
-
-    /**
-     * Swap two randomly chosen papers in the conference
-     */
-    void swapTwoRandomPapers(Conference *conference);
-
-
-    /**
-     * Calculate the score on swapping two papers
-     * @param conference conference containing papers
-     * @param indexes specifying two papers
-     * @return score if the two papers are swapped
-     */
-    double getScoreOnSwapping(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
-
-
-    bool greedyStep();
-
-
-    bool greedyStep2();
-
-
-    void randomSwapping(int maximumIterations);
-
-
-    /**
-     * climbing step of Hill Climbing Algorithm
-     * @return true if the climb is succesful otherwise false
-     */
-    bool climbStep();
-
-
-    /**
-     * Similarity score for all the papers in a session
-     * @param conference corresponding conference for the session
-     * @param trackIndex is the track index
-     * @param sessionIndex is the session index
-     */
-    double getSimilarityScoreForSession(Conference &conference, int trackIndex, int sessionIndex);
-
-    /**
-     * Parallel score for two competing sessions
-     * @param conference corresponding conference for the sessions
-     * @param trackIndex1 is the track index for first session
-     * @param sessionIndex1 is the session index for first session
-     * @param trackIndex2 is the track index for second session
-     * @param sessionIndex2 is the session index for second session
-     */
-    double getParallelScoreBetweenSessions(Conference &conference, int trackIndex1, int sessionIndex1, int trackIndex2, int sessionIndex2);
-
-    /**
-     * Score for the session with all other parallel sessions in the same time slot
-     * @param conference corresponding conference for the session
-     * @param trackIndex is the track index
-     * @param sessionIndex is the session index
-     */
-    double getParallelScoreForSession(Conference &conference, int trackIndex, int sessionIndex);
-
-
-    /**
-     * Score the conference.
-     * @param conference for which score is to be calculated
-     * @return the score of the conference.
-     */
-    double scoreConference(Conference &conference);
-
-    /**
-     * write the conference to output file
-     * @conference conference to be written
-     */
-    void writeConference(Conference &conference);
-    
-    void localBeamSearch(int beamSize);
-
-public:
-    SessionOrganizer();
-    SessionOrganizer(string inputFileName, string outputFileName, time_t starting_time);
-    
-    /**
-     * Get the distance matrix.
-     * @return the distance matrix.
-     */
-    double** getDistanceMatrix();
-
-
-    /**
-     * Organize the papers according to some algorithm.
-     */
-    void organizePapers();
-    
-
-    /**
-     * Print the current organization
-     */
-    void printSessionOrganiser();
-
-    /**
-     * returns the score for conference
-     * @return score of the conference
-     */
-    double getConferenceScore();
-
-};
-
-#endif	/* SESSIONORGANIZER_H */
-
+/* 
+ * File:   SessionOrganizer.h
+ * Author: Harishchandra Patidar
+ *
+ */
+
+#ifndef SESSIONORGANIZER_H
+#define	SESSIONORGANIZER_H
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <mutex>
+#include <random>
+#include <unistd.h>
+#include <time.h>
+
+
+#include "Conference.h"
+#include "Track.h"
+#include "Session.h"
+#include "VisitedStateCache.h"
+#include "CandidateLists.h"
+#include "InstanceStatistics.h"
+#include "SwapBatch.h"
+#include "Incumbent.h"
+#include "Checkpoint.h"
+#include "MoveSampler.h"
+#include "OperatorBandit.h"
+#include "ScheduleConstraints.h"
+#include "QuantizedDistanceMatrix.h"
+#include "SessionKernels.h"
+#include "MatrixAllocator.h"
+#include "IslandSegment.h"
+
+using namespace std;
+
+/**
+ * A changed entry of the similarity matrix.
+ */
+struct DistanceUpdate {
+    int paper1;
+    int paper2;
+    double distance;
+};
+
+/**
+ * The position of a paper in a conference.
+ */
+struct PaperSlot {
+    int trackIndex;
+    int sessionIndex;
+    int paperIndex;
+};
+
+/**
+ * SessionOrganizer reads in a similarity matrix of papers, and organizes them
+ * into sessions and tracks.
+ * 
+ * @author Harishchandra Patidar
+ *
+ */
+class SessionOrganizer {
+private:
+    // ways of choosing the papers removed by a large neighbourhood search step
+    enum DestroyHeuristic { RANDOM_DESTROY, RELATED_DESTROY, WORST_DESTROY, NUMBER_OF_DESTROY_HEURISTICS };
+
+    // operators of a hill climbing step, chosen by climbBandit
+    enum ClimbOperator { GREEDY_OPERATOR, TIME_SLOT_GREEDY_OPERATOR, RANDOM_SWAPPING_OPERATOR, RANDOM_KICK_OPERATOR, NUMBER_OF_CLIMB_OPERATORS };
+
+    // engines run side by side by the portfolio search
+    enum PortfolioEngine { CLIMB_ENGINE, LNS_ENGINE, CROSSOVER_ENGINE, CONSTRUCTION_ENGINE, NUMBER_OF_PORTFOLIO_ENGINES };
+
+    // the distances as read, NULL once the search keeps them only in the
+    // fixed point matrix
+    double **distanceMatrix;
+
+    // the rows of the distance matrix, one block allocated with the memory
+    // policy, NULL while the matrix is shared with other islands
+    double *distanceBlock;
+    MatrixAllocator::Policy memoryPolicy;
+
+    int parallelTracks ;
+    int papersInSession ;
+    int sessionsInTrack ;
+
+    Conference *conference;
+
+    double processingTimeInMinutes ;
+    double tradeoffCoefficient ; // the tradeoff coefficient
+
+    time_t starting_time;
+    string outputFileName;
+
+    double globalMaximumScore;
+
+    // the schedule last written to the output file
+    Conference bestConference;
+
+    // the best schedule of the threads of the LNS and portfolio engines, which
+    // they offer to without locks, and which writes the output file
+    Incumbent incumbent;
+    long long takenIncumbentVersion;
+
+    // updates of the distance matrix waiting to be applied by the search
+    vector<DistanceUpdate> pendingUpdates;
+    mutex pendingUpdatesMutex;
+
+    // file polled for updates of the distance matrix, empty for none
+    string updatesFileName;
+    time_t updatesFileTime;
+
+    // the search algorithm used by organizePapers
+    string searchMode;
+
+    // random number generator of the main search thread
+    mt19937 randomGenerator;
+
+    // random number generator of the exchanges with other islands, which a
+    // worker thread may make while the main thread saves randomGenerator
+    mt19937 islandGenerator;
+
+    // hashes of the conferences explored by the search engines
+    VisitedStateCache visitedStates;
+
+    // the most similar and most dissimilar papers of every paper
+    CandidateLists candidateLists;
+
+    // row sums, extremes, symmetry and units of the distances, found while parsing
+    InstanceStatistics statistics;
+
+    // schedule file used to warm start the search, empty for a random start
+    string warmStartFileName;
+
+    // the last audit of the kept scores and the largest error it found
+    time_t lastScoreAuditTime;
+    double worstScoreDrift;
+
+    // the shared memory of the island model, and the last exchange with the other islands
+    string islandName;
+    IslandSegment island;
+    time_t lastMigrationTime;
+
+    // learns which climbing operator gains the most score per CPU time
+    OperatorBandit climbBandit;
+
+    // hard constraints every conference of the search must meet
+    ScheduleConstraints constraints;
+
+    // settings of the beam search and the greedy step, tuned per instance shape
+    int beamSize;
+    int staleIterations;
+    int greedySamples;
+
+    // bound on the score of any conference, in the units of the search, and
+    // the relative gap to it at which the search stops, 0 for none
+    double upperBound;
+    double gapThreshold;
+
+    // the best distinct local optima of the beam searches, best first, which
+    // the restarts of the beam search are built from
+    vector<Conference> elitePool;
+    int numberOfRestarts;
+
+    // the state of the search, written next to the output file every few
+    // seconds, and whether organizePapers resumes from the one found there
+    Checkpoint checkpoint;
+    time_t lastCheckpointTime;
+    bool resumeSearch;
+
+    // the beam of a resumed beam search, its best conference and its
+    // iterations without improvement, taken by the next beam search
+    vector<Conference> resumedBeam;
+    Conference resumedOptimalConference;
+    int resumedIterations;
+
+    // fixed point copy of the distance matrix used for scoring, when asked
+    // for and every distance is a whole number of its units
+    QuantizedDistanceMatrix quantizedMatrix;
+    bool quantizeDistances;
+
+    // sums over sessions of the distances as read, unrolled for papersInSession
+    SessionKernels<DoubleRows> sessionKernels;
+
+    // scores are kept in units of scoreUnit: a session pair is worth
+    // similarityWeight * (distanceOne - distance) and a parallel pair
+    // parallelWeight * distance, distances in the units of the scoring matrix
+    double similarityWeight;
+    double parallelWeight;
+    double distanceOne;
+    double scoreUnit;
+
+    /**
+     * Read in the number of parallel tracks, papers in session, sessions
+     * in a track, and the similarity matrix from the specified filename.
+     * @param filename is the name of the file containing the matrix.
+     */
+    void readInInputFile(string filename);
+
+    /**
+     * Parse the rows of the distance matrix in parallel, and pass every row
+     * to the instance statistics and the candidate lists right after it is
+     * parsed, while it is still in cache.
+     * @param lines the start of every line of the input file and the end of
+     *        the last one, or NULL to analyze the rows already in the matrix
+     */
+    void readInRows(const vector<const char*> *lines);
+
+    /**
+     * Quantize the distance matrix if asked for and exact, and choose the
+     * units of the scores.
+     */
+    void initializeDistanceStorage();
+
+    /**
+     * Free the double matrix once the fixed point matrix holds every distance,
+     * unless the rows are shared with other islands or given by the caller.
+     */
+    void releaseDistanceMatrix();
+
+    /**
+     * Build the double matrix again from the fixed point matrix, for updates
+     * the fixed point matrix can not hold.
+     */
+    void restoreDistanceMatrix();
+
+    /**
+     * Distance between two papers in the units of the scoring matrix.
+     */
+    double getScoringDistance(int paper1, int paper2)
+    {
+        return quantizedMatrix.getScale() > 0 ? quantizedMatrix.getDistance(paper1, paper2) : distanceMatrix[paper1][paper2];
+    }
+
+    /**
+     * Convert a score kept by the search into the score of the conference.
+     * @param score score in the units of the search
+     * @return the score of the conference
+     */
+    double getReportedScore(double score);
+
+    /**
+     * Read the time, the shape of the conference and the tradeoff coefficient
+     * from the first five lines of the input file.
+     */
+    void readInHeader(vector<string> &lines);
+
+    /**
+     * Attach to the island model, creating its shared segment if needed.
+     * @param filename is the name of the input file
+     * @param lines the first five lines of the input file
+     * @return true if the matrix was taken from a segment created by another island
+     */
+    bool joinIsland(string filename, vector<string> &lines);
+
+    /**
+     * Copy the papers of a conference into an array in the layout of Conference.
+     */
+    void getSchedule(Conference &conference, vector<int> &papers);
+
+    /**
+     * Fill a conference from an array of papers in the layout of Conference, and score it.
+     * @return false if the array is not a permutation of the papers
+     */
+    bool setSchedule(vector<int> &papers, Conference &conference);
+
+    /**
+     * Trade schedules with the other islands, at most once every few seconds:
+     * publish the best conference as an elite, and take the best schedule of
+     * all islands if it is better, else an elite of another island.
+     * @param optimalConference the best conference of this island
+     * @param immigrant receives the schedule taken, scored
+     * @return true if a schedule was taken
+     */
+    bool exchangeWithIslands(Conference &optimalConference, Conference &immigrant);
+
+    /*
+     * Organize the papers Initially
+     */
+    void initializeOrganization(Conference *conference);
+
+
+    /*
+     * Greedily Organize the papers Initially
+     */
+
+    void initializeGreedyOrganization(Conference *conference);
+
+    /**
+     * Read a schedule in the output format of writeConference into the conference.
+     * Papers which are out of range or already placed are dropped and their
+     * slots are left empty (-1), rows and tracks beyond the current shape are ignored.
+     * @param filename is the name of the schedule file
+     * @param conference conference to be filled
+     * @return true if the file could be read
+     */
+    bool readInScheduleFile(string filename, Conference &conference);
+
+    /**
+     * Place every paper missing from the conference into an empty slot,
+     * choosing for each paper the slot with the best gain in score.
+     * @param conference partially filled conference
+     * @return the number of papers placed
+     */
+    int repairOrganization(Conference &conference);
+
+    /**
+     * Gain in score of putting a paper in an empty slot, counting only the
+     * papers already placed in the session and in its parallel sessions.
+     * @param conference partially filled conference
+     * @param paperId the paper to be placed
+     * @param indexes specifying the empty slot
+     * @return the gain in score
+     */
+    double getInsertionGain(Conference &conference, int paperId, int trackIndex, int sessionIndex, int paperIndex);
+
+    /**
+     * Organize the papers starting from the warm start schedule file
+     * @return true if the schedule file could be used
+     */
+    bool initializeWarmOrganization(Conference *conference);
+
+    /**
+     * swap two papers in the conference
+     * @param indexes specifying the papers to be swapped
+     */
+    void swapPapers(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
+
+
+    /**
+     * Swap two randomly chosen papers in the conference
+     */
+    void swapTwoRandomPapers(Conference *conference);
+
+
+    /**
+     * Whether papers may be moved to new slots without breaking a constraint.
+     * Only the moved papers are checked, against where their constrained
+     * partners are after the move; papers without constraints are skipped.
+     * The partners are counted by the conference, so a moved paper is checked
+     * in O(1) plus a lookup for every other moved paper.
+     * @param conference conference containing the papers
+     * @param papers the moved papers, -1 for empty slots
+     * @param destinations the slots the papers move to
+     * @param numberOfPapers the number of moved papers
+     * @return true if every moved paper is allowed at its destination
+     */
+    bool isMoveFeasible(Conference &conference, const int *papers, const PaperSlot *destinations, int numberOfPapers);
+
+    /**
+     * Whether swapping two papers keeps the constraints.
+     * @param conference conference containing papers
+     * @param indexes specifying two papers
+     */
+    bool isSwapFeasible(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
+
+    /**
+     * Whether rotating papers (as rotatePapers does) keeps the constraints.
+     */
+    bool isRotationFeasible(Conference &conference, const PaperSlot *slots, int numberOfSlots);
+
+    /**
+     * Whether every placed paper of a conference meets its constraints.
+     */
+    bool isConferenceFeasible(Conference &conference);
+
+    /**
+     * Move every paper that breaks a constraint, or the partners in its way,
+     * by random swaps that both swapped papers allow.
+     * @param conference conference to be repaired
+     * @param generator random number generator
+     * @return the number of papers still breaking a constraint
+     */
+    int repairConstraints(Conference &conference, mt19937 &generator);
+
+    /**
+     * Calculate the score on swapping two papers
+     * @param conference conference containing papers
+     * @param indexes specifying two papers
+     * @return score if the two papers are swapped, lowest possible if the swap breaks a constraint
+     */
+    double getScoreOnSwapping(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
+
+
+    bool greedyStep();
+
+
+    bool greedyStep2();
+
+
+    void randomSwapping(int maximumIterations);
+
+    /**
+     * Pick two random slots in different sessions. Safe to call from several
+     * threads, each with its own generator.
+     * @param generator random number generator
+     * @param indexes receive the two slots
+     */
+    void pickRandomSlots(mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2);
+
+    /**
+     * Swap random pairs of papers of a conference, skipping the infeasible
+     * swaps. Safe to call from several threads, each with its own generator.
+     * @param conference the conference, scored
+     * @param numberOfSwaps the number of swaps tried
+     * @param generator random number generator
+     */
+    void kickConference(Conference &conference, int numberOfSwaps, mt19937 &generator);
+
+    /**
+     * Propose a swap from the candidate lists: a random paper joins the session
+     * of one of its similar papers, or one of its dissimilar papers moves into
+     * a session parallel to it. Safe to call from several threads.
+     * @param conference conference the swap is for
+     * @param generator random number generator
+     * @param indexes receive the two slots
+     * @return false if the drawn candidate gives no useful swap
+     */
+    bool proposeCandidateSwap(Conference &conference, mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2);
+
+    /**
+     * Pick a swap for a local search, mostly from the candidate lists and
+     * otherwise uniformly at random so that every swap stays reachable.
+     * @param conference conference the swap is for
+     * @param generator random number generator
+     * @param indexes receive the two slots
+     */
+    void pickSwap(Conference &conference, mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2);
+
+    /**
+     * Whether swaps can be evaluated in batches, which needs distances
+     * known to be symmetric.
+     */
+    bool canBatchSwaps();
+
+    /**
+     * Find the change in score of every swap of the batch, together if the
+     * distances allow it and one at a time otherwise.
+     * @param conference conference the swaps were added for
+     * @param batch the swaps, receives their changes in score
+     */
+    void evaluateSwapBatch(Conference &conference, SwapBatch &batch);
+
+    /**
+     * Draw a batch of feasible swaps, and make the best one if it increases
+     * the score. Safe to call from several threads, each with its own generator.
+     * @param conference conference to be improved
+     * @param generator random number generator
+     * @param batch scratch space for the swaps
+     * @param numberOfMoves the number of swaps drawn, at most SWAP_BATCH_SIZE
+     * @param candidates whether swaps are drawn from the candidate lists too
+     * @return true if a swap was made
+     */
+    bool batchSwapStep(Conference &conference, mt19937 &generator, SwapBatch &batch, int numberOfMoves, bool candidates);
+
+    /**
+     * Score the swaps of a batch, and add a copy of the conference with the
+     * swap made for every swap reaching the minimum score and not visited before.
+     * @param conference conference the swaps were added for
+     * @param batch the swaps, emptied
+     * @param minimumScore the lowest score of a neighbour worth keeping
+     * @param neighbours receives the neighbours
+     */
+    void addSwapNeighbours(Conference &conference, SwapBatch &batch, double minimumScore, vector<Conference> &neighbours);
+
+    /**
+     * Score of the given sessions: their similarity scores and their parallel
+     * scores, each pair of parallel sessions counted once.
+     * @param conference conference containing the sessions
+     * @param slots slots whose sessions are scored, sessions may repeat
+     * @param numberOfSlots the number of slots
+     * @return the score of the distinct sessions
+     */
+    double getScoreOfSessions(Conference &conference, const PaperSlot *slots, int numberOfSlots);
+
+    /**
+     * Move the papers along a cycle of slots without scoring: the paper in every
+     * slot goes to the next slot and the paper in the last slot to the first,
+     * or the other way round if backward.
+     */
+    void movePapers(Conference &conference, const PaperSlot *slots, int numberOfSlots, bool backward);
+
+    /**
+     * Move the papers along a cycle of slots, updating the score from the
+     * sessions holding the slots only.
+     * @return the change in score
+     */
+    double rotatePapers(Conference &conference, const PaperSlot *slots, int numberOfSlots);
+
+    /**
+     * Calculate the change in score on moving the papers along a cycle of slots.
+     * The conference is left as it was.
+     * @return the change in score if the papers are moved
+     */
+    double getDeltaOnRotating(Conference &conference, const PaperSlot *slots, int numberOfSlots);
+
+    /**
+     * Pick a rotation of three papers in three different sessions: a random
+     * paper joins the session of a similar paper, the paper it displaces goes
+     * to a third session and the paper displaced there takes the free slot.
+     * @param conference conference the rotation is for
+     * @param generator random number generator
+     * @param slots receive the three slots
+     * @return false if no rotation was found
+     */
+    bool pickRotation(Conference &conference, mt19937 &generator, PaperSlot *slots);
+
+    /**
+     * Ejection chain: a random paper moves to the session of a similar paper,
+     * ejecting the paper there least similar to it, which moves on in the same
+     * way. The chain is closed back to the first slot after every ejection and
+     * the best improving closed chain is applied.
+     * @param conference conference to be improved
+     * @param generator random number generator
+     * @return true if the score increased
+     */
+    bool ejectionChainStep(Conference &conference, mt19937 &generator);
+
+    /**
+     * Swap, rotate or move along ejection chains random papers of the conference
+     * while the score increases, until maximumIterations moves in a row fail to
+     * increase it. Each kind of move gets a fixed share of the time.
+     * @param conference conference to be improved
+     * @param maximumIterations number of failed moves before stopping
+     * @param generator random number generator
+     */
+    void randomSwapping(Conference &conference, int maximumIterations, mt19937 &generator);
+
+
+    /**
+     * climbing step of Hill Climbing Algorithm. The operator is chosen by
+     * climbBandit from the score each operator gained per CPU microsecond.
+     * @return true if the climb is succesful otherwise false
+     */
+    bool climbStep();
+
+    /**
+     * Apply one climbing operator to the conference.
+     * @param op the operator
+     * @return true if the score increased
+     */
+    bool applyClimbOperator(ClimbOperator op);
+
+
+    /**
+     * Similarity score for all the papers in a session
+     * @param conference corresponding conference for the session
+     * @param trackIndex is the track index
+     * @param sessionIndex is the session index
+     */
+    double getSimilarityScoreForSession(Conference &conference, int trackIndex, int sessionIndex);
+
+    /**
+     * Parallel score for two competing sessions
+     * @param conference corresponding conference for the sessions
+     * @param trackIndex1 is the track index for first session
+     * @param sessionIndex1 is the session index for first session
+     * @param trackIndex2 is the track index for second session
+     * @param sessionIndex2 is the session index for second session
+     */
+    double getParallelScoreBetweenSessions(Conference &conference, int trackIndex1, int sessionIndex1, int trackIndex2, int sessionIndex2);
+
+    /**
+     * Score for the session with all other parallel sessions in the same time slot
+     * @param conference corresponding conference for the session
+     * @param trackIndex is the track index
+     * @param sessionIndex is the session index
+     */
+    double getParallelScoreForSession(Conference &conference, int trackIndex, int sessionIndex);
+
+
+    /**
+     * Score of one time slot: the similarity scores of its sessions and the
+     * parallel scores between them, summed with compensation.
+     * @param conference conference containing the time slot
+     * @param sessionIndex the index of the time slot
+     */
+    double getTimeSlotScore(Conference &conference, int sessionIndex);
+
+    /**
+     * Score the conference from scratch, replacing its kept score. The time
+     * slots are scored in parallel and added up with compensated summation.
+     * @param conference for which score is to be calculated
+     * @param numberOfThreads the number of threads scoring the time slots
+     * @return the score of the conference.
+     */
+    double scoreConference(Conference &conference, int numberOfThreads = 1);
+
+    /**
+     * Check whether the scores are due for an audit, at most every few seconds.
+     * Not safe to call from several threads.
+     */
+    bool isScoreAuditDue();
+
+    /**
+     * Rescore a conference and correct its kept score, recording the drift.
+     * @param conference conference whose score was kept incrementally
+     * @return the difference between the kept and the full score
+     */
+    double auditScore(Conference &conference);
+
+    /**
+     * Audit the score of the best conference and of globalMaximumScore with it.
+     */
+    void auditBestScore();
+
+    /**
+     * Upper bound on the score of any conference. Every paper has papersInSession - 1
+     * session mates and (parallelTracks - 1) * papersInSession parallel papers, so
+     * half the sum over the papers of their best such pairs bounds the score.
+     * The rows are bounded in parallel.
+     * @param numberOfThreads the number of threads
+     * @return the bound in the units of the search
+     */
+    double computeUpperBound(int numberOfThreads);
+
+    /**
+     * Whether the best score is within the gap threshold of the upper bound.
+     */
+    bool isGapClosed();
+
+    /**
+     * write the conference to output file
+     * @conference conference to be written
+     */
+    void writeConference(Conference &conference);
+
+    /**
+     * write a schedule in the layout of Conference to the output file
+     * @param papers the schedule
+     * @param score its score in the units of the search
+     */
+    void writeSchedule(const vector<int> &papers, double score);
+
+    /**
+     * returns the name of the checkpoint file of the output file
+     * @return the name of the output file followed by .checkpoint
+     */
+    string getCheckpointFileName();
+
+    /**
+     * Put the state of the search into the checkpoint and write it in the
+     * background, at most every few seconds: the elapsed time, the random
+     * generator, the best conference, the elite pool, and the beam of a
+     * beam search. Other searches are resumed with the best conference only.
+     * @param beam the beam of the beam search, NULL for other searches
+     * @param optimalConference the best conference of the beam
+     * @param iterations the iterations of the beam without improvement
+     */
+    void saveCheckpoint(vector<Conference> *beam = NULL, Conference *optimalConference = NULL, int iterations = 0);
+
+    /**
+     * Restore the state of the search from the checkpoint, into the current
+     * conference, and move the starting time back by the time the checkpointed
+     * run had used, so the search gets the rest of its time.
+     * @return false if there is no checkpoint of this instance
+     */
+    bool loadCheckpoint();
+
+    /**
+     * Start the incumbent from the best conference, writing the output file
+     * whenever a thread improves on it.
+     */
+    void startIncumbent();
+
+    /**
+     * Offer a conference to the incumbent. Safe to call from several threads.
+     * @param conference the conference
+     * @return true if it is the best conference so far
+     */
+    bool offerIncumbent(Conference &conference);
+
+    /**
+     * Copy the incumbent into the best conference, if it is better.
+     */
+    void takeIncumbent();
+
+    /**
+     * Change in score of a conference when one entry of the distance matrix changes.
+     * Only the slots of the two papers are looked at.
+     * @param conference conference containing the papers
+     * @param paper1 row of the changed entry
+     * @param paper2 column of the changed entry
+     * @param oldDistance the value before the change
+     * @param newDistance the value after the change
+     * @return the change in score
+     */
+    double getScoreDeltaForDistanceUpdate(Conference &conference, int paper1, int paper2, double oldDistance, double newDistance);
+
+    /**
+     * Change the distance matrix and update the scores of the given conferences
+     * and of the best conference written so far.
+     * @param updates changed entries of the distance matrix
+     * @param conferences conferences whose scores are to be kept up to date
+     */
+    void applyDistanceUpdates(const vector<DistanceUpdate> &updates, vector<Conference*> &conferences);
+
+    /**
+     * Apply the queued updates and the updates file, if it changed, to the
+     * beam and to the best conference of the current search.
+     * @return true if the distance matrix changed
+     */
+    bool applyPendingDistanceUpdates(vector<Conference> &beam, Conference &optimalConference);
+
+    /**
+     * Queue the entries of the updates file if it changed since the last read.
+     * Every line of the file is "paper1 paper2 distance".
+     */
+    void readInUpdatesFile();
+    
+    /**
+     * Local beam search until the best conference stops improving. The beam
+     * starts from a random conference, the warm start conference, or a
+     * restart built from the elite pool once it holds conferences.
+     * @param beamSize the number of conferences in the beam
+     * @param warmStart whether to start from the current conference
+     */
+    void localBeamSearch(int beamSize, bool warmStart = false);
+
+    /**
+     * Offer a conference to the elite pool. A conference close to an elite
+     * may only replace that elite, otherwise it replaces the worst one.
+     * @param conference the conference offered
+     * @return true if the conference was taken into the pool
+     */
+    bool offerElite(Conference &conference);
+
+    /**
+     * Relabel the time slots and tracks of a conference to match those of a
+     * reference conference as far as possible. The score is unchanged.
+     * @param reference the conference to match
+     * @param conference the conference to relabel
+     * @param aligned receives the relabeled conference, scored
+     */
+    void alignConference(Conference &reference, Conference &conference, Conference &aligned);
+
+    /**
+     * Path relinking: walk from one conference towards another by swaps that
+     * each put a paper into its session in the target, taking the best of a
+     * few candidate swaps at every step.
+     * @param from the conference the walk starts from
+     * @param to the conference the walk heads for
+     * @param result receives the best conference strictly between the two
+     * @param generator random number generator
+     * @return false if the conferences are too close for an intermediate
+     */
+    bool relinkConferences(Conference &from, Conference &to, Conference &result, mt19937 &generator);
+
+    /**
+     * Build the starting conference of a beam search restart, by relinking
+     * two elites or perturbing one, or a random conference while the pool is empty.
+     * @param restart receives the conference, scored
+     */
+    void generateRestart(Conference &restart);
+
+    /**
+     * Check that the distance between every two papers is the same both ways
+     * @return true if the distance matrix is symmetric
+     */
+    bool isDistanceMatrixSymmetric();
+
+    /**
+     * Find an optimal organization by branch and bound, starting from a hill climbed one
+     * @return false if the exact search can not be used for the input
+     */
+    bool exactSearch();
+
+    /**
+     * Number of papers whose session mates differ between two conferences
+     * @return the distance between the conferences
+     */
+    int getSessionDistance(Conference &conference1, Conference &conference2);
+
+    /**
+     * Build a child from whole time slots of two parents, each time slot coming
+     * from one of them. Papers taken twice are dropped from the slots of the
+     * first parent and the missing papers are placed by repairOrganization.
+     * @param parent1 the first parent
+     * @param parent2 the second parent
+     * @param child receives the child, scored
+     * @param generator random number generator
+     */
+    void crossoverConferences(Conference &parent1, Conference &parent2, Conference &child, mt19937 &generator);
+
+    /**
+     * Memetic search: a population of conferences evolved by crossover and a
+     * short local search of every child, children built in parallel. A child
+     * close to a member of the population may only replace that member.
+     * @param populationSize the number of conferences in the population
+     * @param warmStart whether the population keeps the current conference
+     *        and a few kicked copies of it
+     */
+    void memeticSearch(int populationSize, bool warmStart = false);
+
+    /**
+     * Contribution of a placed paper to the score: its pairs with its session
+     * mates and with the papers of the parallel sessions.
+     * @param conference conference containing the paper
+     * @param paperId the paper
+     * @return the contribution of the paper
+     */
+    double getPaperContribution(Conference &conference, int paperId);
+
+    /**
+     * Remove papers from the conference, leaving their slots empty (-1).
+     * @param conference conference to be destroyed in part
+     * @param numberOfPapers the number of papers to remove
+     * @param heuristic random papers, papers similar to a random paper, or
+     *        papers chosen among those contributing least to the score
+     * @param generator random number generator
+     * @param papers receives the removed papers
+     */
+    void destroyPapers(Conference &conference, int numberOfPapers, DestroyHeuristic heuristic, mt19937 &generator, vector<int> &papers);
+
+    /**
+     * Put removed papers back into the empty slots, solving the assignment of
+     * papers to slots with the maximum total insertion gain. The conference is scored.
+     * @param conference conference with as many empty slots as removed papers
+     * @param papers the removed papers
+     */
+    void repairByAssignment(Conference &conference, vector<int> &papers);
+
+    /**
+     * Measure the speed of the scoring functions with the current memory policy:
+     * every thread scores random swaps of its own copy of the conference.
+     */
+    void benchmarkScoring();
+
+    /**
+     * Large neighbourhood search: threads repeatedly destroy part of the best
+     * conference and repair it by assignment, keeping repairs that are no worse.
+     */
+    void largeNeighbourhoodSearch();
+
+    /**
+     * Hill climbing with the operator of every step chosen by climbBandit,
+     * until the time is up.
+     */
+    void hillClimbSearch();
+
+    /**
+     * One step of an engine of the portfolio search. Each engine keeps its own
+     * current conference, which the step replaces when it finds one no worse.
+     * Safe to call from several threads, each with its own generator.
+     * @param engine the engine
+     * @param currents the current conference of every engine
+     * @param currentMutexes guard the current conferences
+     * @param generator random number generator
+     * @param candidate receives the conference built by the step, scored
+     */
+    void portfolioStep(PortfolioEngine engine, Conference *currents, mutex *currentMutexes, mt19937 &generator, Conference &candidate);
+
+    /**
+     * Share the turns of the worker threads among the engines: one each, the
+     * rest in proportion to the credit of the engines, evenly if none has any.
+     * @param credits the credit of every engine
+     * @param numberOfTurns the number of turns
+     * @param turnsOfEngine receives the number of turns of every engine
+     */
+    void allocatePortfolioTurns(vector<double> &credits, int numberOfTurns, vector<int> &turnsOfEngine);
+
+    /**
+     * Portfolio search: one worker thread per core runs the steps of several
+     * engines, each thread taking the turns of the engines in order. Every
+     * epoch the turns are shared out again, more of them going to the engines
+     * that improved the best conference most recently.
+     */
+    void portfolioSearch();
+
+public:
+    SessionOrganizer();
+    /**
+     * Constructor for SessionOrganizer.
+     *
+     * @param inputFileName is the name of the input file.
+     * @param outputFileName is the name of the output file.
+     * @param starting_time is the time the run started.
+     * @param islandName is the name of the island model to join, empty to run alone.
+     */
+    SessionOrganizer(string inputFileName, string outputFileName, time_t starting_time, string islandName = "");
+    
+    /**
+     * Constructor for scoring only, from a distance matrix owned by the caller.
+     *
+     * @param distanceMatrix is the distance matrix of the papers.
+     * @param parallelTracks is the number of parallel tracks.
+     * @param sessionsInTrack is the number of sessions in a track.
+     * @param papersInSession is the number of papers in a session.
+     * @param tradeoffCoefficient is the tradeoff coefficient.
+     */
+    SessionOrganizer(double **distanceMatrix, int parallelTracks, int sessionsInTrack, int papersInSession, double tradeoffCoefficient);
+
+    /**
+     * Score a schedule given as paper ids in the layout of Conference, the
+     * papers of session s of track t at (t * sessionsInTrack + s) * papersInSession.
+     * Safe to call from several threads.
+     * @param papers the schedule
+     * @param score receives the score
+     * @return false if the schedule does not place every paper exactly once
+     */
+    bool scoreSchedule(vector<int> &papers, double &score);
+
+    /**
+     * Get the distance matrix.
+     * @return the distance matrix, NULL once the search keeps the distances
+     *         only in the fixed point matrix.
+     */
+    double** getDistanceMatrix();
+
+    /**
+     * Start the search from a previously written schedule instead of a random one.
+     * @param fileName is the name of the schedule file
+     */
+    void setWarmStartFile(string fileName);
+
+    /**
+     * Resume the search from the checkpoint of an earlier run with the same
+     * output file, for the rest of the time of that run.
+     * @param resume whether to resume
+     */
+    void setResume(bool resume);
+
+    /**
+     * Delete the checkpoint of the run, which is no longer needed once the
+     * search has finished.
+     */
+    void removeCheckpoint();
+
+    /**
+     * Choose the search algorithm: "beam" (default), "exact", "memetic", "lns",
+     * "climb" or "portfolio", or "benchmark" to measure the speed of the
+     * scoring functions.
+     * @param mode is the name of the search algorithm
+     */
+    void setSearchMode(string mode);
+
+    /**
+     * Choose how the distances are stored for scoring: "quantized" (default)
+     * keeps them as 8 or 16 bit fixed point values with exact integer scores
+     * when every distance and the tradeoff coefficient allow it, "double"
+     * keeps the distances as read.
+     * @param storage is the name of the storage
+     */
+    void setDistanceStorage(string storage);
+
+    /**
+     * Choose the page size and NUMA placement of the distance matrix: "default",
+     * "thp" (transparent huge pages), "hugetlb" (huge page pool), "interleave"
+     * (pages spread over the NUMA nodes) or "replicate" (a copy of the fixed
+     * point matrix on every node, the double matrix interleaved). The matrix
+     * is moved to the new memory.
+     * @param policy is the name of the policy
+     */
+    void setMemoryPolicy(string policy);
+
+    /**
+     * Stop the search once the best score is within a fraction of the upper
+     * bound on the score, 0 to use the whole time.
+     * @param gap is the relative optimality gap to stop at
+     */
+    void setGapThreshold(double gap);
+
+    /**
+     * Take the search settings from the row of a tuning table written by the
+     * tuner whose instance shape is closest to this one. Every row is
+     * "papersInSession parallelTracks sessionsInTrack beamSize staleIterations
+     * greedySamples", lines starting with '#' are comments.
+     * @param fileName is the name of the tuning table
+     */
+    void setTuningFile(string fileName);
+
+    /**
+     * Run for the given time instead of the time in the input file.
+     * @param minutes is the processing time in minutes
+     */
+    void setProcessingTime(double minutes);
+
+    /**
+     * Read hard constraints from a file with one per line: "conflict paper1
+     * paper2" (not in parallel), "pin paper timeSlot" (only in that time slot,
+     * or any of the time slots it is pinned to) or "apart paper1 paper2" (not
+     * in the same session). Lines starting with '#' are comments.
+     * @param fileName is the name of the constraints file
+     */
+    void setConstraintsFile(string fileName);
+
+    /**
+     * Poll a file for updates of the distance matrix during the search.
+     * @param fileName is the name of the updates file
+     */
+    void setUpdatesFile(string fileName);
+
+    /**
+     * Queue changed entries of the distance matrix. They are applied to the
+     * running search at the start of its next iteration, updating the scores
+     * only for the sessions holding the changed papers. May be called from
+     * another thread.
+     * @param updates changed entries of the distance matrix
+     */
+    void queueDistanceUpdates(const vector<DistanceUpdate> &updates);
+
+    /**
+     * Apply changed entries of the distance matrix right away, to the current
+     * organization and the best conference.
+     * @param updates changed entries of the distance matrix
+     */
+    void applyDistanceUpdates(const vector<DistanceUpdate> &updates);
+
+
+    /**
+     * Organize the papers according to some algorithm.
+     */
+    void organizePapers();
+    
+
+    /**
+     * Print the current organization
+     */
+    void printSessionOrganiser();
+
+    /**
+     * returns the score for conference
+     * @return score of the conference
+     */
+    double getConferenceScore();
+
+    /**
+     * returns how far the best score may be below the optimal score, relative
+     * to the upper bound on the score
+     * @return the optimality gap
+     */
+    double getOptimalityGap();
+
+    /**
+     * returns what was learned about the distances while reading them
+     * @return the statistics, not valid once the distances are updated
+     */
+    InstanceStatistics& getInstanceStatistics();
+
+};
+
+#endif	/* SESSIONORGANIZER_H */
+
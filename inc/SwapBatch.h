@@ -0,0 +1,133 @@
+/*
+ * File:   SwapBatch.h
+ *
+ */
+
+#ifndef SWAPBATCH_H
+#define	SWAPBATCH_H
+
+#include <vector>
+
+#include "Conference.h"
+#include "QuantizedDistanceMatrix.h"
+
+using namespace std;
+
+// the largest number of swaps evaluated together, a multiple of the SIMD width
+#define SWAP_BATCH_SIZE 64
+
+/**
+ * SwapBatch evaluates many swaps of two papers of a conference at once. The
+ * moves are kept as a structure of arrays, so the change in score of four
+ * moves at a time is found with AVX2 gathers from the distance matrix, double
+ * or fixed point, where the processor has them, and with plain loops over the
+ * moves elsewhere.
+ *
+ * Swapping paper a with paper b changes the score only through the pairs of
+ * a and b with the other papers of their time slots: a paper q of the time
+ * slot of a adds w * (d(a, q) - d(b, q)), where w is the similarity weight if
+ * q shares the session of a and minus the parallel weight otherwise, and the
+ * same for b the other way round. This holds for symmetric distances only.
+ */
+class SwapBatch {
+private:
+    int numberOfMoves;
+    int papersInSession;
+    int positionsInSlot;
+
+    // the moves, one entry per move
+    int trackIndex1[SWAP_BATCH_SIZE];
+    int sessionIndex1[SWAP_BATCH_SIZE];
+    int paperIndex1[SWAP_BATCH_SIZE];
+    int trackIndex2[SWAP_BATCH_SIZE];
+    int sessionIndex2[SWAP_BATCH_SIZE];
+    int paperIndex2[SWAP_BATCH_SIZE];
+    int paper1[SWAP_BATCH_SIZE];
+    int paper2[SWAP_BATCH_SIZE];
+    double deltas[SWAP_BATCH_SIZE];
+
+    // the addresses of the rows of the two papers of every move, in doubles
+    // or in fixed point units of getBits() bits
+    long long rowAddresses1[SWAP_BATCH_SIZE];
+    long long rowAddresses2[SWAP_BATCH_SIZE];
+
+    // the papers of the time slots of the two papers, indexed
+    // [position in the time slot * SWAP_BATCH_SIZE + move]
+    vector<int> slotPapers1;
+    vector<int> slotPapers2;
+
+    /**
+     * Gather the papers of the time slots of the moves, and pad the moves
+     * to a multiple of the SIMD width.
+     * @return the number of moves with the padding
+     */
+    int prepare(Conference &conference);
+
+    /**
+     * Find the changes in score with plain loops, or with AVX2, from rows
+     * of distances of type T.
+     */
+    template<typename T>
+    void evaluateScalar(double similarityWeight, double parallelWeight);
+    void evaluateAvx2(double similarityWeight, double parallelWeight);
+    void evaluateAvx2Units(int bits, double similarityWeight, double parallelWeight);
+
+public:
+    SwapBatch();
+
+    /**
+     * Remove every move.
+     */
+    void clear();
+
+    /**
+     * returns the number of moves in the batch
+     * @return the number of moves
+     */
+    int getNumberOfMoves();
+
+    /**
+     * Add a swap of two papers of the conference. The batch must not be full.
+     */
+    void addMove(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2);
+
+    /**
+     * Gets the slots of the two papers of a move.
+     */
+    void getMove(int move, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2);
+
+    /**
+     * Find the change in score of every move, for a symmetric distance matrix.
+     *
+     * @param conference is the conference the moves were added for.
+     * @param distanceMatrix is the symmetric distance matrix of the papers.
+     * @param similarityWeight is the score of a unit of similarity in a session.
+     * @param parallelWeight is the score of a unit of distance between parallel sessions.
+     */
+    void evaluate(Conference &conference, double **distanceMatrix, double similarityWeight, double parallelWeight);
+
+    /**
+     * Find the change in score of every move, for a symmetric fixed point matrix.
+     *
+     * @param conference is the conference the moves were added for.
+     * @param quantizedMatrix is the symmetric fixed point matrix of the papers.
+     * @param similarityWeight is the score of a unit of similarity in a session.
+     * @param parallelWeight is the score of a unit of distance between parallel sessions.
+     */
+    void evaluate(Conference &conference, QuantizedDistanceMatrix &quantizedMatrix, double similarityWeight, double parallelWeight);
+
+    /**
+     * Gets or sets the change in score of a move.
+     */
+    double getDelta(int move);
+    void setDelta(int move, double delta);
+
+    /**
+     * returns the move with the largest change in score
+     * @return the index of the move, -1 if the batch is empty
+     */
+    int getBestMove();
+};
+
+#endif	/* SWAPBATCH_H */
+
@@ -0,0 +1,52 @@
+/*
+ * File:   VisitedStateCache.h
+ *
+ */
+
+#ifndef VISITEDSTATECACHE_H
+#define	VISITEDSTATECACHE_H
+
+#include <atomic>
+
+using namespace std;
+
+/**
+ * VisitedStateCache remembers the hashes of conferences already explored, in
+ * a fixed size table of small buckets. When a bucket is full an old hash is
+ * overwritten, so a state may be forgotten but is never reported visited
+ * unless its hash was inserted. Safe to share between threads without locks.
+ */
+class VisitedStateCache {
+private:
+    atomic<unsigned long long> *entries;
+
+    // the number of buckets minus one
+    unsigned long long bucketMask;
+
+    VisitedStateCache(const VisitedStateCache &anotherCache);
+    VisitedStateCache & operator=(const VisitedStateCache &anotherCache);
+
+public:
+    /**
+     * Constructor for VisitedStateCache.
+     *
+     * @param log2Entries is the base 2 logarithm of the number of hashes kept.
+     */
+    VisitedStateCache(int log2Entries);
+    ~VisitedStateCache();
+
+    /**
+     * Insert the hash of a state.
+     * @param hash the hash of the state
+     * @return true if the hash was already in the cache
+     */
+    bool insert(unsigned long long hash);
+
+    /**
+     * Forget all states.
+     */
+    void clear();
+};
+
+#endif	/* VISITEDSTATECACHE_H */
+
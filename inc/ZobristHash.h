@@ -0,0 +1,59 @@
+/*
+ * File:   ZobristHash.h
+ *
+ */
+
+#ifndef ZOBRISTHASH_H
+#define	ZOBRISTHASH_H
+
+/**
+ * Keys and mixing functions for hashing a conference.
+ *
+ * A session hashes to the sum of the keys of its papers, a time slot to the
+ * sum of the mixed hashes of its sessions and a conference to the sum of the
+ * mixed hashes of its time slots. The hash of a conference therefore does not
+ * change with the order of papers in a session, of tracks or of time slots, and
+ * is updated in O(1) when a paper changes.
+ */
+class ZobristHash {
+public:
+    /**
+     * Mix the bits of a value (splitmix64 finalizer)
+     */
+    static inline unsigned long long mix(unsigned long long value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    /**
+     * The key of a paper, 0 for an empty slot
+     */
+    static inline unsigned long long getPaperKey(int paperId)
+    {
+        return paperId < 0 ? 0 : mix((unsigned long long)paperId + 0x9e3779b97f4a7c15ULL);
+    }
+
+    /**
+     * The contribution of a session to the hash of its time slot
+     */
+    static inline unsigned long long mixSession(unsigned long long sessionHash)
+    {
+        return mix(sessionHash ^ 0x2545f4914f6cdd1dULL);
+    }
+
+    /**
+     * The contribution of a time slot to the hash of the conference
+     */
+    static inline unsigned long long mixSlot(unsigned long long slotHash)
+    {
+        return mix(slotHash ^ 0x5851f42d4c957f2dULL);
+    }
+};
+
+#endif	/* ZOBRISTHASH_H */
+
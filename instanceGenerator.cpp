@@ -0,0 +1,258 @@
+/*
+ * File:   instanceGenerator.cpp
+ *
+ * Writes an input file with a planted schedule, and the planted schedule in
+ * the output format of ./a.out. Distances are drawn in hundredths from three
+ * bands, by where the two papers are in the planted schedule:
+ *
+ *   same session                        0.00 to 0.29
+ *   different time slots                0.30 to 0.70
+ *   same time slot, parallel sessions   0.71 to 1.00
+ *
+ * Every schedule has as many session pairs as there are pairs in the lowest
+ * band, and as many parallel pairs as there are in the highest band, so the
+ * planted schedule takes the best possible pairs of both kinds at once and
+ * is optimal. With an overlap the bands are widened by that many hundredths
+ * on both sides; the planted schedule is then only near optimal, and the
+ * upper bound of SessionOrganizer is printed next to its score. Papers are
+ * numbered in a random order, so the planted schedule has to be found.
+ *
+ * Usage: ./generator <input_filename> <schedule_filename> <papersInSession>
+ *        <parallelTracks> <sessionsInTrack> [<tradeoff> <minutes> <overlap> <seed>]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+// the largest number of papers of a generated instance
+#define MAXIMUM_PAPERS 10000
+
+// the bands of distances in hundredths, before the overlap is added
+#define SESSION_BAND_END 29
+#define PARALLEL_BAND_START 71
+
+/**
+ * The shape of the planted schedule and the seed of its distances.
+ */
+struct PlantedInstance {
+	int papersInSession;
+	int parallelTracks;
+	int sessionsInTrack;
+	int overlap;
+	unsigned long long seed;
+
+	// the position of every paper in the planted schedule, in the layout of Conference
+	vector<int> positions;
+
+	/**
+	 * Distance between two papers in hundredths, the same both ways.
+	 */
+	int getDistance(int paper1, int paper2) const
+	{
+		if(paper1 == paper2)
+			return 0;
+
+		int position1 = positions[paper1];
+		int position2 = positions[paper2];
+		int session1 = position1 / papersInSession;
+		int session2 = position2 / papersInSession;
+		int timeSlot1 = session1 % sessionsInTrack;
+		int timeSlot2 = session2 % sessionsInTrack;
+
+		int low = 30, high = 70;
+		if(session1 == session2)
+		{
+			low = 0;
+			high = SESSION_BAND_END;
+		}
+		else if(timeSlot1 == timeSlot2)
+		{
+			low = PARALLEL_BAND_START;
+			high = 100;
+		}
+		low = max(0, low - overlap);
+		high = min(100, high + overlap);
+
+		// a pair is hashed from its smaller paper first, so the matrix is symmetric
+		unsigned long long hash = seed + (unsigned long long)min(paper1, paper2) * 0x9e3779b97f4a7c15ULL
+			+ (unsigned long long)max(paper1, paper2) * 0xc2b2ae3d27d4eb4fULL;
+		hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+		hash ^= hash >> 31;
+		return low + (int)(hash % (high - low + 1));
+	}
+};
+
+/**
+ * Write the input file, one row of the distance matrix at a time.
+ * @return false if the file can not be written
+ */
+static bool writeInstance(const string &fileName, const PlantedInstance &instance, double tradeoff, double minutes)
+{
+	FILE *file = fopen(fileName.c_str(), "w");
+	if(file == NULL)
+		return false;
+
+	int numberOfPapers = instance.positions.size();
+	fprintf(file, "%g\n%d\n%d\n%d\n%g\n", minutes, instance.papersInSession, instance.parallelTracks, instance.sessionsInTrack, tradeoff);
+
+	vector<char> line(numberOfPapers * 5 + 2);
+	for(int paper1 = 0; paper1 < numberOfPapers; paper1++)
+	{
+		char *position = &line[0];
+		for(int paper2 = 0; paper2 < numberOfPapers; paper2++)
+		{
+			int distance = instance.getDistance(paper1, paper2);
+			*position++ = '0' + distance / 100;
+			*position++ = '.';
+			*position++ = '0' + distance / 10 % 10;
+			*position++ = '0' + distance % 10;
+			*position++ = paper2 == numberOfPapers - 1 ? '\n' : ' ';
+		}
+		fwrite(&line[0], 1, position - &line[0], file);
+	}
+
+	return fclose(file) == 0;
+}
+
+/**
+ * Write the planted schedule in the output format of ./a.out, and find its score.
+ * @return false if the file can not be written
+ */
+static bool writeSchedule(const string &fileName, const PlantedInstance &instance, double tradeoff, double &score)
+{
+	ofstream file(fileName.c_str());
+	if(!file.is_open())
+		return false;
+
+	int papersInSession = instance.papersInSession;
+	int numberOfPapers = instance.positions.size();
+	vector<int> papers(numberOfPapers);
+	for(int paper = 0; paper < numberOfPapers; paper++)
+		papers[instance.positions[paper]] = paper;
+
+	score = 0.0;
+	for(int sessionIndex = 0; sessionIndex < instance.sessionsInTrack; sessionIndex++)
+	{
+		for(int trackIndex = 0; trackIndex < instance.parallelTracks; trackIndex++)
+		{
+			const int *session = &papers[(trackIndex * instance.sessionsInTrack + sessionIndex) * papersInSession];
+			for(int i = 0; i < papersInSession; i++)
+			{
+				file << session[i] << " ";
+
+				// pairs within the session, and with the sessions of the later tracks
+				for(int j = i + 1; j < papersInSession; j++)
+					score += 1.0 - instance.getDistance(session[i], session[j]) / 100.0;
+				for(int otherTrack = trackIndex + 1; otherTrack < instance.parallelTracks; otherTrack++)
+				{
+					const int *other = &papers[(otherTrack * instance.sessionsInTrack + sessionIndex) * papersInSession];
+					for(int j = 0; j < papersInSession; j++)
+						score += tradeoff * instance.getDistance(session[i], other[j]) / 100.0;
+				}
+			}
+			if(trackIndex != instance.parallelTracks - 1)
+				file << "| ";
+		}
+		file << "\n";
+	}
+
+	file.close();
+	return !file.fail();
+}
+
+/**
+ * Upper bound on the score of any schedule, found as SessionOrganizer does:
+ * every paper with its best session mates and best parallel papers, halved.
+ */
+static double computeUpperBound(const PlantedInstance &instance, double tradeoff)
+{
+	int numberOfPapers = instance.positions.size();
+	int sessionMates = instance.papersInSession - 1;
+	int parallelMates = (instance.parallelTracks - 1) * instance.papersInSession;
+
+	double bound = 0.0;
+	vector<int> distances(numberOfPapers - 1);
+	for(int paper = 0; paper < numberOfPapers; paper++)
+	{
+		for(int other = 0, count = 0; other < numberOfPapers; other++)
+		{
+			if(other != paper)
+				distances[count++] = instance.getDistance(paper, other);
+		}
+
+		nth_element(distances.begin(), distances.begin() + sessionMates, distances.end());
+		for(int i = 0; i < sessionMates; i++)
+			bound += 1.0 - distances[i] / 100.0;
+		nth_element(distances.begin(), distances.begin() + parallelMates, distances.end(), greater<int>());
+		for(int i = 0; i < parallelMates; i++)
+			bound += tradeoff * distances[i] / 100.0;
+	}
+	return bound / 2;
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 6)
+	{
+		cout << "./generator <input_filename> <schedule_filename> <papersInSession> <parallelTracks> <sessionsInTrack> [<tradeoff> <minutes> <overlap> <seed>]" << endl;
+		return 2;
+	}
+
+	PlantedInstance instance;
+	instance.papersInSession = atoi(argv[3]);
+	instance.parallelTracks = atoi(argv[4]);
+	instance.sessionsInTrack = atoi(argv[5]);
+	double tradeoff = argc > 6 ? atof(argv[6]) : 1.0;
+	double minutes = argc > 7 ? atof(argv[7]) : 1.0;
+	instance.overlap = argc > 8 ? atoi(argv[8]) : 0;
+	instance.seed = argc > 9 ? strtoull(argv[9], NULL, 10) : 1;
+
+	long long numberOfPapers = (long long)instance.papersInSession * instance.parallelTracks * instance.sessionsInTrack;
+	if(instance.papersInSession <= 0 || instance.parallelTracks <= 0 || instance.sessionsInTrack <= 0 || numberOfPapers > MAXIMUM_PAPERS)
+	{
+		cout << "The shape must be positive with at most " << MAXIMUM_PAPERS << " papers" << endl;
+		return 2;
+	}
+	if(instance.overlap < 0 || tradeoff < 0)
+	{
+		cout << "The overlap and the tradeoff must not be negative" << endl;
+		return 2;
+	}
+
+	// the papers are placed in a random order
+	instance.positions.resize(numberOfPapers);
+	for(int paper = 0; paper < numberOfPapers; paper++)
+		instance.positions[paper] = paper;
+	mt19937 generator(instance.seed);
+	shuffle(instance.positions.begin(), instance.positions.end(), generator);
+
+	if(!writeInstance(argv[1], instance, tradeoff, minutes))
+	{
+		cout << "Unable to write input file " << argv[1] << endl;
+		return 2;
+	}
+
+	double score;
+	if(!writeSchedule(argv[2], instance, tradeoff, score))
+	{
+		cout << "Unable to write schedule file " << argv[2] << endl;
+		return 2;
+	}
+
+	printf("%lld papers, planted score %.2f", numberOfPapers, score);
+	if(instance.overlap > 0)
+		printf(", upper bound %.2f\n", computeUpperBound(instance, tradeoff));
+	else
+		printf(", optimal\n");
+	return 0;
+}
@@ -1,2 +1,2 @@
 #!/bin/bash
-./a.out $1 $2 
\ No newline at end of file
+./a.out "$@"
\ No newline at end of file
@@ -0,0 +1,372 @@
+/*
+ * File:   scheduleValidator.cpp
+ *
+ * Checks schedule files against an input file and scores them with the
+ * scoring code of SessionOrganizer. Prints one JSON object per schedule:
+ *
+ *   {"file":"out.txt","valid":true,"score":123.45}
+ *   {"file":"bad.txt","valid":false,"error":"paper 7 placed twice"}
+ *
+ * Usage: ./validator <input_filename> <schedule_filename>...
+ * With "-" in place of the schedule files, their names are read from stdin.
+ * The exit status is 0 if every schedule is valid.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SessionOrganizer.h"
+
+using namespace std;
+
+/**
+ * A file mapped into memory, read only.
+ */
+struct MappedFile {
+	const char *data;
+	size_t size;
+
+	MappedFile() : data(NULL), size(0) {}
+
+	bool open(const string &fileName)
+	{
+		int descriptor = ::open(fileName.c_str(), O_RDONLY);
+		if(descriptor < 0)
+			return false;
+
+		struct stat status;
+		if(fstat(descriptor, &status) != 0)
+		{
+			close(descriptor);
+			return false;
+		}
+
+		size = status.st_size;
+		data = "";
+		if(size > 0)
+		{
+			void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			data = mapping == MAP_FAILED ? NULL : (const char*)mapping;
+			if(data != NULL)
+				madvise(mapping, size, MADV_SEQUENTIAL);
+		}
+		close(descriptor);
+		return data != NULL;
+	}
+
+	~MappedFile()
+	{
+		if(data != NULL && size > 0)
+			munmap((void*)data, size);
+	}
+};
+
+/**
+ * Read the next whitespace separated token of [position, end) as a number.
+ * @return false if there is no token or it is not a number
+ */
+static bool readNumber(const char *&position, const char *end, double &value)
+{
+	while(position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+		position++;
+
+	// the mapping is not null terminated, so the token is copied out
+	char token[64];
+	int length = 0;
+	while(position < end && length < 63 && !(*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n' || *position == '|'))
+		token[length++] = *position++;
+	token[length] = '\0';
+
+	char *tokenEnd;
+	value = strtod(token, &tokenEnd);
+	return length > 0 && *tokenEnd == '\0';
+}
+
+/**
+ * The start of every line of a file.
+ */
+static void findLines(const MappedFile &file, vector<const char*> &lines)
+{
+	const char *position = file.data;
+	const char *end = file.data + file.size;
+	while(position < end)
+	{
+		lines.push_back(position);
+		const char *newline = (const char*)memchr(position, '\n', end - position);
+		position = newline == NULL ? end : newline + 1;
+	}
+	lines.push_back(end);
+}
+
+/**
+ * Whether a line holds nothing but whitespace.
+ */
+static bool isBlank(const char *position, const char *end)
+{
+	for(; position < end; position++)
+	{
+		if(!(*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Read a schedule in the output format of SessionOrganizer: one line per
+ * time slot, the sessions of the parallel tracks separated by '|'.
+ * @param papers receives the papers in the layout of Conference
+ * @param error receives the reason the file is rejected
+ * @return false if the format is wrong
+ */
+static bool readInSchedule(const MappedFile &file, int parallelTracks, int sessionsInTrack, int papersInSession, vector<int> &papers, string &error)
+{
+	vector<const char*> lines;
+	findLines(file, lines);
+
+	papers.assign(parallelTracks * sessionsInTrack * papersInSession, -1);
+	int sessionIndex = 0;
+	for(int line = 0; line + 1 < lines.size(); line++)
+	{
+		const char *position = lines[line];
+		const char *end = lines[line + 1];
+		if(isBlank(position, end))
+			continue;
+
+		if(sessionIndex == sessionsInTrack)
+		{
+			error = "more than " + to_string(sessionsInTrack) + " time slots";
+			return false;
+		}
+
+		for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+		{
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				double value;
+				if(!readNumber(position, end, value) || value != (int)value)
+				{
+					error = "time slot " + to_string(sessionIndex) + " track " + to_string(trackIndex) + ": expected " + to_string(papersInSession) + " paper ids";
+					return false;
+				}
+				papers[(trackIndex * sessionsInTrack + sessionIndex) * papersInSession + paperIndex] = (int)value;
+			}
+
+			// the sessions of a time slot are separated by '|'
+			while(position < end && (*position == ' ' || *position == '\t' || *position == '\r'))
+				position++;
+			bool separator = position < end && *position == '|';
+			if(trackIndex + 1 < parallelTracks ? !separator : separator)
+			{
+				error = "time slot " + to_string(sessionIndex) + ": expected " + to_string(parallelTracks) + " sessions separated by '|'";
+				return false;
+			}
+			if(separator)
+				position++;
+		}
+
+		if(!isBlank(position, end))
+		{
+			error = "time slot " + to_string(sessionIndex) + ": unexpected text after the last session";
+			return false;
+		}
+		sessionIndex++;
+	}
+
+	if(sessionIndex != sessionsInTrack)
+	{
+		error = "expected " + to_string(sessionsInTrack) + " time slots, found " + to_string(sessionIndex);
+		return false;
+	}
+
+	// every paper exactly once, the first offending paper is reported
+	int totalNumberOfPapers = papers.size();
+	vector<char> placed(totalNumberOfPapers, 0);
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		if(papers[i] < 0 || papers[i] >= totalNumberOfPapers)
+		{
+			error = "paper " + to_string(papers[i]) + " out of range";
+			return false;
+		}
+		if(placed[papers[i]]++)
+		{
+			error = "paper " + to_string(papers[i]) + " placed twice";
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Quote a string for JSON.
+ */
+static string quote(const string &text)
+{
+	string quoted = "\"";
+	for(int i = 0; i < text.size(); i++)
+	{
+		if(text[i] == '"' || text[i] == '\\')
+			quoted += '\\';
+		if((unsigned char)text[i] < 0x20)
+			quoted += ' ';
+		else
+			quoted += text[i];
+	}
+	return quoted + "\"";
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 3)
+	{
+		cout << "./validator <input_filename> <schedule_filename>... (or - to read the schedule filenames from stdin)" << endl;
+		return 2;
+	}
+
+	vector<string> scheduleFileNames;
+	for(int i = 2; i < argc; i++)
+	{
+		string fileName(argv[i]);
+		if(fileName == "-")
+		{
+			string line;
+			while(getline(cin, line))
+			{
+				if(!line.empty())
+					scheduleFileNames.push_back(line);
+			}
+		}
+		else
+		{
+			scheduleFileNames.push_back(fileName);
+		}
+	}
+
+	// the input file: time, k, p, t, C and the distance matrix
+	MappedFile input;
+	if(!input.open(argv[1]))
+	{
+		cout << "{\"file\":" << quote(argv[1]) << ",\"valid\":false,\"error\":\"unable to open input file\"}" << endl;
+		return 2;
+	}
+
+	vector<const char*> lines;
+	findLines(input, lines);
+	double header[5];
+	for(int i = 0; i < 5; i++)
+	{
+		const char *position = i < lines.size() - 1 ? lines[i] : input.data + input.size;
+		if(!readNumber(position, input.data + input.size, header[i]))
+		{
+			cout << "{\"file\":" << quote(argv[1]) << ",\"valid\":false,\"error\":\"bad header line " << i + 1 << "\"}" << endl;
+			return 2;
+		}
+	}
+
+	int papersInSession = (int)header[1];
+	int parallelTracks = (int)header[2];
+	int sessionsInTrack = (int)header[3];
+	double tradeoffCoefficient = header[4];
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	if(totalNumberOfPapers <= 0 || lines.size() - 1 < 5 + totalNumberOfPapers)
+	{
+		cout << "{\"file\":" << quote(argv[1]) << ",\"valid\":false,\"error\":\"expected " << totalNumberOfPapers << " rows of distances\"}" << endl;
+		return 2;
+	}
+
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+
+	// the rows of the matrix are parsed in parallel
+	vector<double> distances((size_t)totalNumberOfPapers * totalNumberOfPapers);
+	vector<double*> distanceMatrix(totalNumberOfPapers);
+	atomic<int> badRow(-1);
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++)
+	{
+		threads.push_back(thread([&, t]() {
+			for(int row = t; row < totalNumberOfPapers; row += numberOfThreads)
+			{
+				distanceMatrix[row] = &distances[(size_t)row * totalNumberOfPapers];
+				const char *position = lines[5 + row];
+				const char *end = lines[6 + row];
+				for(int column = 0; column < totalNumberOfPapers; column++)
+				{
+					if(!readNumber(position, end, distanceMatrix[row][column]))
+						badRow = row;
+				}
+				if(!isBlank(position, end))
+					badRow = row;
+			}
+		}));
+	}
+	for(int t = 0; t < numberOfThreads; t++)
+	{
+		threads[t].join();
+	}
+	if(badRow >= 0)
+	{
+		cout << "{\"file\":" << quote(argv[1]) << ",\"valid\":false,\"error\":\"row " << badRow << " of the distance matrix does not have " << totalNumberOfPapers << " numbers\"}" << endl;
+		return 2;
+	}
+
+	SessionOrganizer organizer(&distanceMatrix[0], parallelTracks, sessionsInTrack, papersInSession, tradeoffCoefficient);
+
+	// the schedules are checked in parallel, the results printed in order
+	vector<string> results(scheduleFileNames.size());
+	atomic<int> nextSchedule(0);
+	atomic<bool> allValid(true);
+	threads.clear();
+	for(int t = 0; t < numberOfThreads; t++)
+	{
+		threads.push_back(thread([&]() {
+			vector<int> papers;
+			for(int i = nextSchedule++; i < scheduleFileNames.size(); i = nextSchedule++)
+			{
+				ostringstream result;
+				result.precision(15);
+				result << "{\"file\":" << quote(scheduleFileNames[i]);
+
+				MappedFile schedule;
+				string error;
+				double score;
+				if(!schedule.open(scheduleFileNames[i]))
+					error = "unable to open schedule file";
+				else if(readInSchedule(schedule, parallelTracks, sessionsInTrack, papersInSession, papers, error) && !organizer.scoreSchedule(papers, score))
+					error = "schedule could not be scored";
+
+				if(error.empty())
+				{
+					result << ",\"valid\":true,\"score\":" << score << "}";
+				}
+				else
+				{
+					result << ",\"valid\":false,\"error\":" << quote(error) << "}";
+					allValid = false;
+				}
+				results[i] = result.str();
+			}
+		}));
+	}
+	for(int t = 0; t < numberOfThreads; t++)
+	{
+		threads[t].join();
+	}
+
+	for(int i = 0; i < results.size(); i++)
+	{
+		cout << results[i] << '\n';
+	}
+	cout.flush();
+
+	return allValid ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/*
+ * File:   settingsTuner.cpp
+ *
+ * Races settings of the beam search (beam size, stale iterations before a
+ * restart, random partners tried per paper by the greedy step) on a corpus of
+ * input files. Every configuration is run with the same seeds, and after each
+ * round of seeds the worse half of the configurations by mean score is
+ * dropped. The runs are timed, so they are made one after the other, each
+ * with the whole machine as in the runs the table is for. The winner for
+ * every input file is written as a row of a tuning table that ./a.out reads
+ * with --tuning:
+ *
+ *   papersInSession parallelTracks sessionsInTrack beamSize staleIterations greedySamples
+ *
+ * Usage: ./tuner <table_filename> <minutes_per_run> <input_filename>...
+ * ./a.out and ./validator are run from the directory of the tuner.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+
+// rounds of seeds, and the rounds before any configuration is dropped
+#define MAXIMUM_ROUNDS 6
+#define MINIMUM_ROUNDS 2
+
+/**
+ * Settings of the beam search raced by the tuner.
+ */
+struct Settings {
+	int beamSize;
+	int staleIterations;
+	int greedySamples;
+
+	// scores of the runs so far, one per round
+	vector<double> scores;
+
+	double getMeanScore() const
+	{
+		double sum = 0.0;
+		for(int i = 0; i < scores.size(); i++)
+			sum += scores[i];
+		return scores.empty() ? 0.0 : sum / scores.size();
+	}
+};
+
+/**
+ * Read papersInSession, parallelTracks and sessionsInTrack from an input file.
+ * @return false if the file can not be read
+ */
+static bool readInShape(const string &fileName, int shape[3])
+{
+	ifstream file(fileName.c_str());
+	double processingTime;
+	return (bool)(file >> processingTime >> shape[0] >> shape[1] >> shape[2]) && shape[0] > 0 && shape[1] > 0 && shape[2] > 0;
+}
+
+/**
+ * Run the organizer on an input file with some settings and seed, and
+ * score its schedule with the validator.
+ * @return the score, or a very low score if the schedule is not valid
+ */
+static double runSettings(const string &directory, const string &inputFileName, const Settings &settings, const string &minutes, int seed, int job)
+{
+	string prefix = "/tmp/tuner_" + to_string(getpid()) + "_" + to_string(job);
+	string tableFileName = prefix + "_table.txt";
+	string outputFileName = prefix + "_output.txt";
+
+	ofstream table(tableFileName.c_str());
+	table << "1 1 1 " << settings.beamSize << " " << settings.staleIterations << " " << settings.greedySamples << endl;
+	table.close();
+
+	string command = directory + "/a.out " + inputFileName + " " + outputFileName + " --tuning " + tableFileName
+		+ " --time " + minutes + " --seed " + to_string(seed) + " > /dev/null 2>&1";
+	int status = system(command.c_str());
+
+	double score = -1e300;
+	command = directory + "/validator " + inputFileName + " " + outputFileName;
+	FILE *validator = status == -1 ? NULL : popen(command.c_str(), "r");
+	if(validator != NULL)
+	{
+		char line[4096];
+		if(fgets(line, sizeof(line), validator) != NULL)
+		{
+			const char *value = strstr(line, "\"score\":");
+			if(value != NULL)
+				score = atof(value + strlen("\"score\":"));
+		}
+		pclose(validator);
+	}
+
+	remove(tableFileName.c_str());
+	remove(outputFileName.c_str());
+
+	// a run that did not finish leaves its checkpoint behind
+	remove((outputFileName + ".checkpoint").c_str());
+	remove((outputFileName + ".checkpoint.tmp").c_str());
+	return score;
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 4)
+	{
+		cout << "./tuner <table_filename> <minutes_per_run> <input_filename>..." << endl;
+		return 2;
+	}
+
+	string argument0(argv[0]);
+	string directory = argument0.find('/') == string::npos ? "." : argument0.substr(0, argument0.rfind('/'));
+	string minutes(argv[2]);
+
+	ofstream table(argv[1]);
+	if(!table.is_open())
+	{
+		cout << "Unable to write tuning table " << argv[1] << endl;
+		return 2;
+	}
+	table << "# papersInSession parallelTracks sessionsInTrack beamSize staleIterations greedySamples" << endl;
+
+	for(int instance = 3; instance < argc; instance++)
+	{
+		string inputFileName(argv[instance]);
+		int shape[3];
+		if(!readInShape(inputFileName, shape))
+		{
+			cout << "Skipping " << inputFileName << ", unable to read it" << endl;
+			continue;
+		}
+
+		const int beamSizes[] = { 25, 50, 100, 200 };
+		const int staleIterations[] = { 25, 50, 100, 200 };
+		const int greedySamples[] = { 1, 2, 4 };
+		vector<Settings> survivors;
+		for(int i = 0; i < 4; i++)
+		{
+			for(int j = 0; j < 4; j++)
+			{
+				for(int l = 0; l < 3; l++)
+				{
+					Settings settings;
+					settings.beamSize = beamSizes[i];
+					settings.staleIterations = staleIterations[j];
+					settings.greedySamples = greedySamples[l];
+					survivors.push_back(settings);
+				}
+			}
+		}
+
+		for(int round = 1; round <= MAXIMUM_ROUNDS && survivors.size() > 1; round++)
+		{
+			// the configurations of a round run with the same seed
+			for(int i = 0; i < survivors.size(); i++)
+			{
+				survivors[i].scores.push_back(runSettings(directory, inputFileName, survivors[i], minutes, round, i));
+			}
+
+			sort(survivors.begin(), survivors.end(), [](const Settings &a, const Settings &b) {
+				return a.getMeanScore() > b.getMeanScore();
+			});
+			if(round >= MINIMUM_ROUNDS)
+				survivors.resize((survivors.size() + 1) / 2);
+
+			cout << inputFileName << " round " << round << ": " << survivors.size() << " configurations left, best mean score " << survivors[0].getMeanScore() << endl;
+		}
+
+		Settings &winner = survivors[0];
+		table << shape[0] << " " << shape[1] << " " << shape[2] << " "
+			<< winner.beamSize << " " << winner.staleIterations << " " << winner.greedySamples
+			<< " # " << inputFileName << " mean score " << winner.getMeanScore() << endl;
+		cout << inputFileName << ": beam size " << winner.beamSize << ", stale iterations " << winner.staleIterations
+			<< ", greedy samples " << winner.greedySamples << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * File:   AssignmentSolver.cpp
+ *
+ */
+
+#include <limits>
+
+#include "AssignmentSolver.h"
+
+double AssignmentSolver::solve(const vector< vector<double> > &cost, vector<int> &assignment)
+{
+    int n = cost.size();
+    const double infinity = numeric_limits<double>::infinity();
+
+    // potentials of rows and columns, 1-based with column 0 as a sentinel
+    vector<double> rowPotential(n + 1, 0.0), columnPotential(n + 1, 0.0);
+    vector<int> rowOfColumn(n + 1, 0), previousColumn(n + 1, 0);
+
+    for(int row = 1; row <= n; row++)
+    {
+        // find an augmenting path for the row by Dijkstra over reduced costs
+        rowOfColumn[0] = row;
+        int column = 0;
+        vector<double> minimumSlack(n + 1, infinity);
+        vector<bool> used(n + 1, false);
+
+        do {
+            used[column] = true;
+            int currentRow = rowOfColumn[column];
+            double delta = infinity;
+            int nextColumn = 0;
+
+            for(int j = 1; j <= n; j++)
+            {
+                if(used[j])
+                    continue;
+
+                double slack = cost[currentRow - 1][j - 1] - rowPotential[currentRow] - columnPotential[j];
+                if(slack < minimumSlack[j])
+                {
+                    minimumSlack[j] = slack;
+                    previousColumn[j] = column;
+                }
+                if(minimumSlack[j] < delta)
+                {
+                    delta = minimumSlack[j];
+                    nextColumn = j;
+                }
+            }
+
+            for(int j = 0; j <= n; j++)
+            {
+                if(used[j])
+                {
+                    rowPotential[rowOfColumn[j]] += delta;
+                    columnPotential[j] -= delta;
+                }
+                else
+                {
+                    minimumSlack[j] -= delta;
+                }
+            }
+            column = nextColumn;
+        } while(rowOfColumn[column] != 0);
+
+        // flip the path
+        do {
+            int previous = previousColumn[column];
+            rowOfColumn[column] = rowOfColumn[previous];
+            column = previous;
+        } while(column != 0);
+    }
+
+    assignment.assign(n, -1);
+    double totalCost = 0.0;
+    for(int column = 1; column <= n; column++)
+    {
+        assignment[rowOfColumn[column] - 1] = column - 1;
+        totalCost += cost[rowOfColumn[column] - 1][column - 1];
+    }
+    return totalCost;
+}
@@ -0,0 +1,85 @@
+/*
+ * File:   CandidateLists.cpp
+ *
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "CandidateLists.h"
+
+CandidateLists::CandidateLists()
+{
+    numberOfPapers = 0;
+    listSize = 0;
+}
+
+void CandidateLists::buildRow(const double *distances, int paperId, vector<int> &others)
+{
+    if(listSize == 0)
+        return;
+
+    others.clear();
+    for(int other = 0; other < numberOfPapers; other++)
+    {
+        if(other != paperId)
+            others.push_back(other);
+    }
+
+    partial_sort(others.begin(), others.begin() + listSize, others.end(),
+                 [distances](int a, int b) { return distances[a] < distances[b]; });
+    copy(others.begin(), others.begin() + listSize, similarPapers.begin() + paperId * listSize);
+
+    partial_sort(others.begin(), others.begin() + listSize, others.end(),
+                 [distances](int a, int b) { return distances[a] > distances[b]; });
+    copy(others.begin(), others.begin() + listSize, dissimilarPapers.begin() + paperId * listSize);
+}
+
+void CandidateLists::buildRows(double **distanceMatrix, int firstPaper, int stride)
+{
+    vector<int> others;
+    for(int paper = firstPaper; paper < numberOfPapers; paper += stride)
+    {
+        buildRow(distanceMatrix[paper], paper, others);
+    }
+}
+
+void CandidateLists::init(int numberOfPapers, int listSize)
+{
+    this->numberOfPapers = numberOfPapers;
+    this->listSize = max(0, min(listSize, numberOfPapers - 1));
+    similarPapers.assign(numberOfPapers * this->listSize, 0);
+    dissimilarPapers.assign(numberOfPapers * this->listSize, 0);
+}
+
+void CandidateLists::build(double **distanceMatrix, int numberOfPapers, int listSize, int numberOfThreads)
+{
+    init(numberOfPapers, listSize);
+    if(this->listSize == 0)
+        return;
+
+    vector<thread> threads;
+    for(int t = 0; t < numberOfThreads; t++)
+    {
+        threads.push_back(thread(&CandidateLists::buildRows, this, distanceMatrix, t, numberOfThreads));
+    }
+    for(int t = 0; t < numberOfThreads; t++)
+    {
+        threads[t].join();
+    }
+}
+
+int CandidateLists::getListSize()
+{
+    return listSize;
+}
+
+const int* CandidateLists::getSimilarPapers(int paperId)
+{
+    return &similarPapers[paperId * listSize];
+}
+
+const int* CandidateLists::getDissimilarPapers(int paperId)
+{
+    return &dissimilarPapers[paperId * listSize];
+}
@@ -0,0 +1,163 @@
+/*
+ * File:   Checkpoint.cpp
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Checkpoint.h"
+
+// the first bytes of every checkpoint file, changed with its layout
+#define CHECKPOINT_MAGIC "SOCHKPT1"
+#define CHECKPOINT_MAGIC_SIZE 8
+
+Checkpoint::Checkpoint()
+{
+    readPosition = 0;
+    writing = false;
+}
+
+Checkpoint::~Checkpoint()
+{
+    wait();
+}
+
+void Checkpoint::clear()
+{
+    buffer.clear();
+    readPosition = 0;
+}
+
+void Checkpoint::putInteger(long long value)
+{
+    const char *bytes = (const char*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void Checkpoint::putDouble(double value)
+{
+    const char *bytes = (const char*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void Checkpoint::putString(const string &value)
+{
+    putInteger(value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void Checkpoint::putPapers(const vector<int> &papers)
+{
+    putInteger(papers.size());
+    const char *bytes = (const char*)papers.data();
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(int) * papers.size());
+}
+
+bool Checkpoint::get(void *data, size_t size)
+{
+    if(buffer.size() - readPosition < size)
+        return false;
+    memcpy(data, &buffer[readPosition], size);
+    readPosition += size;
+    return true;
+}
+
+bool Checkpoint::getInteger(long long &value)
+{
+    return get(&value, sizeof(value));
+}
+
+bool Checkpoint::getDouble(double &value)
+{
+    return get(&value, sizeof(value));
+}
+
+bool Checkpoint::getString(string &value)
+{
+    long long size;
+    if(!getInteger(size) || size < 0 || (unsigned long long)size > buffer.size() - readPosition)
+        return false;
+    value.assign(&buffer[0] + readPosition, size);
+    readPosition += size;
+    return true;
+}
+
+bool Checkpoint::getPapers(vector<int> &papers)
+{
+    long long size;
+    if(!getInteger(size) || size < 0 || (unsigned long long)size > (buffer.size() - readPosition) / sizeof(int))
+        return false;
+    papers.resize(size);
+    return size == 0 || get(&papers[0], sizeof(int) * size);
+}
+
+bool Checkpoint::save(const string &fileName)
+{
+    if(writing.load())
+        return false;
+    if(writer.joinable())
+        writer.join();
+
+    pending.swap(buffer);
+    clear();
+    writing = true;
+    writer = thread(&Checkpoint::write, this, fileName);
+    return true;
+}
+
+void Checkpoint::write(string fileName)
+{
+    // the checkpoint is replaced only once the new one is complete
+    string temporaryFileName = fileName + ".tmp";
+    ofstream file(temporaryFileName.c_str(), ios::binary | ios::trunc);
+    long long size = pending.size();
+    file.write(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_SIZE);
+    file.write((const char*)&size, sizeof(size));
+    file.write(pending.data(), size);
+    file.close();
+
+    if(file)
+        rename(temporaryFileName.c_str(), fileName.c_str());
+    else
+        cout << "Could not write the checkpoint " << temporaryFileName << endl;
+
+    writing = false;
+}
+
+bool Checkpoint::load(const string &fileName)
+{
+    wait();
+    clear();
+
+    ifstream file(fileName.c_str(), ios::binary);
+    char magic[CHECKPOINT_MAGIC_SIZE];
+    long long size;
+    if(!file.read(magic, CHECKPOINT_MAGIC_SIZE) || memcmp(magic, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_SIZE) != 0)
+        return false;
+    if(!file.read((char*)&size, sizeof(size)) || size < 0)
+        return false;
+
+    buffer.resize(size);
+    if(size > 0 && !file.read(&buffer[0], size))
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void Checkpoint::wait()
+{
+    if(writer.joinable())
+        writer.join();
+}
+
+void Checkpoint::remove(const string &fileName)
+{
+    wait();
+    ::remove(fileName.c_str());
+    ::remove((fileName + ".tmp").c_str());
+}
@@ -1,161 +1,378 @@
-/* 
- * File:   Conference.cpp
- * Author: Harishchandra Patidar
- * 
- */
-
-#include "Conference.h"
-
-Conference::Conference() : tracks(NULL)
-{
-    this->parallelTracks = 0;
-    this->sessionsInTrack = 0;
-    this->papersInSession = 0;
-    this->score = 0.0;
-}
-
-Conference::~Conference()
-{
-    delete [] tracks;
-}
-
-Conference::Conference(int parallelTracks, int sessionsInTrack, int papersInSession)
-{
-    this->parallelTracks = parallelTracks;
-    this->sessionsInTrack = sessionsInTrack;
-    this->papersInSession = papersInSession;
-    this->score = 0.0;
-    initTracks(parallelTracks, sessionsInTrack, papersInSession);
-}
-
-Conference::Conference(const Conference &anotherConference)
-{
-    this->parallelTracks = anotherConference.parallelTracks;
-    this->sessionsInTrack = anotherConference.sessionsInTrack;
-    this->papersInSession = anotherConference.papersInSession;
-    this->score = anotherConference.score;
-
-    this->tracks = new Track[this->parallelTracks];
-
-    for(int i=0; i<this->parallelTracks; i++){
-        this->tracks[i] = anotherConference.tracks[i];
-    }
-}
-
-Conference & Conference::operator=(const Conference &anotherConference)
-{
-    if(this != &anotherConference){
-        delete [] tracks;
-
-        this->parallelTracks = anotherConference.parallelTracks;
-        this->sessionsInTrack = anotherConference.sessionsInTrack;
-        this->papersInSession = anotherConference.papersInSession;
-        this->score = anotherConference.score;
-        
-        this->tracks = new Track[this->parallelTracks];
-
-        for(int i=0; i<this->parallelTracks; i++){
-            this->tracks[i] = anotherConference.tracks[i];
-        }
-    }
-    return *this;
-}
-
-bool Conference::operator < (const Conference &rhs)
-{
-    return this->score < rhs.score;
-}
-
-void Conference::initTracks(int parallelTracks, int sessionsInTrack, int papersInSession)
-{
-    tracks = new Track[parallelTracks];
-    for(int i=0; i<parallelTracks; i++)
-    {
-        Track tempTrack(sessionsInTrack);
-        for (int j=0; j<sessionsInTrack; j++)
-        {
-            Session tempSession(papersInSession);
-            tempTrack.setSession(j,tempSession);
-        }
-        tracks[i] = tempTrack;
-    }
-}
-
-int Conference::getParallelTracks()
-{
-    return parallelTracks;
-}
-
-int Conference::getSessionsInTrack()
-{
-    return sessionsInTrack;
-}
-
-int Conference::getPapersInSession()
-{
-    return papersInSession;
-}
-
-double Conference::getScore()
-{
-    return score;
-}
-
-void Conference::increaseScore(double deltaScore){
-    score += deltaScore;
-}
-
-Track* Conference::getTrack(int trackIndex)
-{
-    if (trackIndex < parallelTracks)
-    {
-        return &tracks[trackIndex];
-    }
-    else
-    {
-        cout << "Index out of bound - Conference::getTrack" << endl;
-        exit(0);
-    }
-}
-
-Session* Conference::getSession(int trackIndex, int sessionIndex)
-{
-    return this->getTrack(trackIndex)->getSession(sessionIndex);
-}
-
-int Conference::getPaper(int trackIndex, int sessionIndex, int paperIndex)
-{
-    return this->getSession(trackIndex,sessionIndex)->getPaper(paperIndex);
-}
-
-void Conference::setPaper(int trackIndex, int sessionIndex, int paperIndex, int paperId)
-{
-    if (this->parallelTracks > trackIndex)
-    {
-        tracks[trackIndex].setPaper(sessionIndex, paperIndex, paperId);
-    }
-    else
-    {
-        cout << "Index out of bound - Conference::setPaper" << endl;
-        exit ( 0 );
-    }
-}
-
-void Conference::printConference()
-{
-    for(int i = 0; i < sessionsInTrack; i++)
-    {
-        for(int j = 0; j < parallelTracks; j++)
-        {
-            for(int k = 0; k < papersInSession; k++)
-            {
-                cout<< tracks[j].getSession(i)->getPaper(k) << " ";
-            }
-            if(j != parallelTracks - 1)
-            {
-                cout<< "| ";
-            }
-        }
-        cout<< "\n";
-    }
-}
+/* 
+ * File:   Conference.cpp
+ * Author: Harishchandra Patidar
+ * 
+ */
+
+#include "Conference.h"
+#include "ScheduleConstraints.h"
+#include "ZobristHash.h"
+
+Conference::Conference() : tracks(NULL), paperLocations(NULL), sessionHashes(NULL), slotHashes(NULL), constraints(NULL), constraintCounts(NULL)
+{
+    this->parallelTracks = 0;
+    this->sessionsInTrack = 0;
+    this->papersInSession = 0;
+    this->score = 0.0;
+    this->hash = 0;
+}
+
+Conference::~Conference()
+{
+    delete [] tracks;
+    delete [] paperLocations;
+    delete [] sessionHashes;
+    delete [] slotHashes;
+    delete [] constraintCounts;
+}
+
+Conference::Conference(int parallelTracks, int sessionsInTrack, int papersInSession)
+{
+    this->parallelTracks = parallelTracks;
+    this->sessionsInTrack = sessionsInTrack;
+    this->papersInSession = papersInSession;
+    this->score = 0.0;
+    this->constraints = NULL;
+    this->constraintCounts = NULL;
+    initTracks(parallelTracks, sessionsInTrack, papersInSession);
+
+    int numberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+    this->paperLocations = new int[numberOfPapers];
+    for(int i=0; i<numberOfPapers; i++){
+        this->paperLocations[i] = -1;
+    }
+
+    // hashes of empty sessions
+    this->sessionHashes = new unsigned long long[parallelTracks * sessionsInTrack];
+    this->slotHashes = new unsigned long long[sessionsInTrack];
+    this->hash = 0;
+    for(int j=0; j<sessionsInTrack; j++){
+        this->slotHashes[j] = 0;
+        for(int i=0; i<parallelTracks; i++){
+            this->sessionHashes[i * sessionsInTrack + j] = 0;
+            this->slotHashes[j] += ZobristHash::mixSession(0);
+        }
+        this->hash += ZobristHash::mixSlot(this->slotHashes[j]);
+    }
+}
+
+Conference::Conference(const Conference &anotherConference)
+{
+    this->parallelTracks = anotherConference.parallelTracks;
+    this->sessionsInTrack = anotherConference.sessionsInTrack;
+    this->papersInSession = anotherConference.papersInSession;
+    this->score = anotherConference.score;
+
+    this->tracks = new Track[this->parallelTracks];
+
+    for(int i=0; i<this->parallelTracks; i++){
+        this->tracks[i] = anotherConference.tracks[i];
+    }
+
+    copyIndexes(anotherConference);
+}
+
+Conference & Conference::operator=(const Conference &anotherConference)
+{
+    if(this != &anotherConference){
+        delete [] tracks;
+        delete [] paperLocations;
+        delete [] sessionHashes;
+        delete [] slotHashes;
+        delete [] constraintCounts;
+
+        this->parallelTracks = anotherConference.parallelTracks;
+        this->sessionsInTrack = anotherConference.sessionsInTrack;
+        this->papersInSession = anotherConference.papersInSession;
+        this->score = anotherConference.score;
+        
+        this->tracks = new Track[this->parallelTracks];
+
+        for(int i=0; i<this->parallelTracks; i++){
+            this->tracks[i] = anotherConference.tracks[i];
+        }
+
+        copyIndexes(anotherConference);
+    }
+    return *this;
+}
+
+void Conference::copyIndexes(const Conference &anotherConference)
+{
+    this->hash = anotherConference.hash;
+    this->constraints = anotherConference.constraints;
+    this->constraintCounts = NULL;
+    if(anotherConference.paperLocations == NULL){
+        this->paperLocations = NULL;
+        this->sessionHashes = NULL;
+        this->slotHashes = NULL;
+        return;
+    }
+
+    int numberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+    this->paperLocations = new int[numberOfPapers];
+    for(int i=0; i<numberOfPapers; i++){
+        this->paperLocations[i] = anotherConference.paperLocations[i];
+    }
+
+    this->sessionHashes = new unsigned long long[parallelTracks * sessionsInTrack];
+    for(int i=0; i<parallelTracks * sessionsInTrack; i++){
+        this->sessionHashes[i] = anotherConference.sessionHashes[i];
+    }
+
+    this->slotHashes = new unsigned long long[sessionsInTrack];
+    for(int i=0; i<sessionsInTrack; i++){
+        this->slotHashes[i] = anotherConference.slotHashes[i];
+    }
+
+    if(anotherConference.constraintCounts != NULL){
+        int numberOfCounts = constraints->getConstrainedPapers().size() * sessionsInTrack * (1 + parallelTracks);
+        this->constraintCounts = new int[numberOfCounts];
+        for(int i=0; i<numberOfCounts; i++){
+            this->constraintCounts[i] = anotherConference.constraintCounts[i];
+        }
+    }
+}
+
+bool Conference::operator < (const Conference &rhs)
+{
+    return this->score < rhs.score;
+}
+
+void Conference::initTracks(int parallelTracks, int sessionsInTrack, int papersInSession)
+{
+    tracks = new Track[parallelTracks];
+    for(int i=0; i<parallelTracks; i++)
+    {
+        Track tempTrack(sessionsInTrack);
+        for (int j=0; j<sessionsInTrack; j++)
+        {
+            Session tempSession(papersInSession);
+            tempTrack.setSession(j,tempSession);
+        }
+        tracks[i] = tempTrack;
+    }
+}
+
+int Conference::getParallelTracks()
+{
+    return parallelTracks;
+}
+
+int Conference::getSessionsInTrack()
+{
+    return sessionsInTrack;
+}
+
+int Conference::getPapersInSession()
+{
+    return papersInSession;
+}
+
+double Conference::getScore()
+{
+    return score;
+}
+
+void Conference::increaseScore(double deltaScore){
+    score += deltaScore;
+}
+
+Track* Conference::getTrack(int trackIndex)
+{
+    if (trackIndex < parallelTracks)
+    {
+        return &tracks[trackIndex];
+    }
+    else
+    {
+        cout << "Index out of bound - Conference::getTrack" << endl;
+        exit(0);
+    }
+}
+
+Session* Conference::getSession(int trackIndex, int sessionIndex)
+{
+    return this->getTrack(trackIndex)->getSession(sessionIndex);
+}
+
+int Conference::getPaper(int trackIndex, int sessionIndex, int paperIndex)
+{
+    return this->getSession(trackIndex,sessionIndex)->getPaper(paperIndex);
+}
+
+void Conference::setPaper(int trackIndex, int sessionIndex, int paperIndex, int paperId)
+{
+    if (this->parallelTracks > trackIndex)
+    {
+        int numberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+        int slot = (trackIndex * sessionsInTrack + sessionIndex) * papersInSession + paperIndex;
+
+        int oldPaperId = tracks[trackIndex].getSession(sessionIndex)->getPaper(paperIndex);
+        if (oldPaperId >= 0 && oldPaperId < numberOfPapers && paperLocations[oldPaperId] == slot)
+        {
+            paperLocations[oldPaperId] = -1;
+        }
+
+        tracks[trackIndex].setPaper(sessionIndex, paperIndex, paperId);
+
+        if (constraintCounts != NULL)
+        {
+            countPartners(oldPaperId, trackIndex, sessionIndex, -1);
+            countPartners(paperId, trackIndex, sessionIndex, 1);
+        }
+
+        if (paperId >= 0 && paperId < numberOfPapers)
+        {
+            paperLocations[paperId] = slot;
+        }
+
+        // update the hashes of the session, its time slot and the conference
+        unsigned long long &sessionHash = sessionHashes[trackIndex * sessionsInTrack + sessionIndex];
+        unsigned long long oldSlotHash = slotHashes[sessionIndex];
+        slotHashes[sessionIndex] -= ZobristHash::mixSession(sessionHash);
+        sessionHash += ZobristHash::getPaperKey(paperId) - ZobristHash::getPaperKey(oldPaperId);
+        slotHashes[sessionIndex] += ZobristHash::mixSession(sessionHash);
+        hash += ZobristHash::mixSlot(slotHashes[sessionIndex]) - ZobristHash::mixSlot(oldSlotHash);
+    }
+    else
+    {
+        cout << "Index out of bound - Conference::setPaper" << endl;
+        exit ( 0 );
+    }
+}
+
+bool Conference::getPaperLocation(int paperId, int &trackIndex, int &sessionIndex, int &paperIndex)
+{
+    int numberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+    if (paperId < 0 || paperId >= numberOfPapers || paperLocations[paperId] < 0)
+    {
+        return false;
+    }
+
+    int slot = paperLocations[paperId];
+    paperIndex = slot % papersInSession;
+    sessionIndex = (slot / papersInSession) % sessionsInTrack;
+    trackIndex = slot / (papersInSession * sessionsInTrack);
+    return true;
+}
+
+unsigned long long Conference::getHash()
+{
+    return hash;
+}
+
+unsigned long long Conference::getHashAfterSwap(int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
+{
+    if (trackIndex1 == trackIndex2 && sessionIndex1 == sessionIndex2)
+    {
+        return hash;
+    }
+
+    int paper1 = getPaper(trackIndex1, sessionIndex1, paperIndex1);
+    int paper2 = getPaper(trackIndex2, sessionIndex2, paperIndex2);
+    unsigned long long difference = ZobristHash::getPaperKey(paper2) - ZobristHash::getPaperKey(paper1);
+
+    unsigned long long sessionHash1 = sessionHashes[trackIndex1 * sessionsInTrack + sessionIndex1];
+    unsigned long long sessionHash2 = sessionHashes[trackIndex2 * sessionsInTrack + sessionIndex2];
+
+    unsigned long long slotChange1 = ZobristHash::mixSession(sessionHash1 + difference) - ZobristHash::mixSession(sessionHash1);
+    unsigned long long slotChange2 = ZobristHash::mixSession(sessionHash2 - difference) - ZobristHash::mixSession(sessionHash2);
+
+    unsigned long long slotHash1 = slotHashes[sessionIndex1];
+    unsigned long long slotHash2 = slotHashes[sessionIndex2];
+
+    if (sessionIndex1 == sessionIndex2)
+    {
+        return hash - ZobristHash::mixSlot(slotHash1) + ZobristHash::mixSlot(slotHash1 + slotChange1 + slotChange2);
+    }
+
+    return hash - ZobristHash::mixSlot(slotHash1) + ZobristHash::mixSlot(slotHash1 + slotChange1)
+                - ZobristHash::mixSlot(slotHash2) + ZobristHash::mixSlot(slotHash2 + slotChange2);
+}
+
+void Conference::printConference()
+{
+    for(int i = 0; i < sessionsInTrack; i++)
+    {
+        for(int j = 0; j < parallelTracks; j++)
+        {
+            for(int k = 0; k < papersInSession; k++)
+            {
+                cout<< tracks[j].getSession(i)->getPaper(k) << " ";
+            }
+            if(j != parallelTracks - 1)
+            {
+                cout<< "| ";
+            }
+        }
+        cout<< "\n";
+    }
+}
+
+void Conference::setConstraints(ScheduleConstraints *constraints)
+{
+    delete [] constraintCounts;
+    this->constraints = constraints;
+    this->constraintCounts = NULL;
+    if (constraints == NULL || paperLocations == NULL)
+    {
+        return;
+    }
+
+    int numberOfCounts = constraints->getConstrainedPapers().size() * sessionsInTrack * (1 + parallelTracks);
+    constraintCounts = new int[numberOfCounts];
+    for (int i = 0; i < numberOfCounts; i++)
+    {
+        constraintCounts[i] = 0;
+    }
+
+    for (int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+    {
+        for (int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+        {
+            for (int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+            {
+                countPartners(getPaper(trackIndex, sessionIndex, paperIndex), trackIndex, sessionIndex, 1);
+            }
+        }
+    }
+}
+
+ScheduleConstraints* Conference::getConstraints()
+{
+    return constraints;
+}
+
+void Conference::countPartners(int paperId, int trackIndex, int sessionIndex, int change)
+{
+    if (!constraints->isConstrained(paperId))
+    {
+        return;
+    }
+
+    int countsPerPaper = sessionsInTrack * (1 + parallelTracks);
+    int session = sessionsInTrack + trackIndex * sessionsInTrack + sessionIndex;
+
+    // a conflicting partner in the same session breaks nothing
+    const vector<int> &conflicts = constraints->getConflicts(paperId);
+    for (int i = 0; i < conflicts.size(); i++)
+    {
+        int *counts = constraintCounts + constraints->getConstrainedIndex(conflicts[i]) * countsPerPaper;
+        counts[sessionIndex] += change;
+        counts[session] -= change;
+    }
+
+    const vector<int> &apart = constraints->getApart(paperId);
+    for (int i = 0; i < apart.size(); i++)
+    {
+        int *counts = constraintCounts + constraints->getConstrainedIndex(apart[i]) * countsPerPaper;
+        counts[session] += change;
+    }
+}
+
+int Conference::getBrokenConstraints(int paperId, int trackIndex, int sessionIndex)
+{
+    const int *counts = constraintCounts + constraints->getConstrainedIndex(paperId) * sessionsInTrack * (1 + parallelTracks);
+    return counts[sessionIndex] + counts[sessionsInTrack + trackIndex * sessionsInTrack + sessionIndex];
+}
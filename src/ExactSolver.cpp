@@ -0,0 +1,431 @@
+/*
+ * File:   ExactSolver.cpp
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "ExactSolver.h"
+
+// bounds within this of the incumbent can not improve it
+#define SCORE_EPSILON 1e-9
+
+// nodes between two looks at the clock
+#define NODES_PER_TIME_CHECK 16384
+
+ExactSolver::ExactSolver(double **distanceMatrix, int parallelTracks, int sessionsInTrack, int papersInSession, double tradeoffCoefficient)
+{
+    this->parallelTracks = parallelTracks;
+    this->sessionsInTrack = sessionsInTrack;
+    this->papersInSession = papersInSession;
+    this->tradeoffCoefficient = tradeoffCoefficient;
+
+    this->numberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+    this->numberOfSessions = parallelTracks * sessionsInTrack;
+
+    this->bestScore = 0.0;
+    this->timeUp = false;
+    this->numberOfNodes = 0;
+
+    orderPapers(distanceMatrix);
+
+    largestSimilarities.resize(numberOfPapers + 1);
+    largestParallels.resize(numberOfPapers + 1);
+    largestPairs.resize(numberOfPapers + 1);
+    vector< atomic<bool> > built(numberOfPapers + 1);
+    boundsBuilt.swap(built);
+}
+
+/**
+ * Prefix sums of the values in decreasing order, counting only positive values
+ * and each at half, as every pair is bounded from both of its papers
+ */
+static vector<double> largestPrefixSums(vector<double> &values)
+{
+    sort(values.begin(), values.end(), greater<double>());
+
+    vector<double> sums(values.size() + 1, 0.0);
+    for(int i = 0; i < values.size(); i++)
+    {
+        sums[i + 1] = sums[i] + 0.5 * max(0.0, values[i]);
+    }
+    return sums;
+}
+
+void ExactSolver::orderPapers(double **distanceMatrix)
+{
+    // papers whose distances are spread widely decide the most, place them first
+    vector<double> spread(numberOfPapers, 0.0);
+    for(int i = 0; i < numberOfPapers; i++)
+    {
+        double sum = 0.0, sumOfSquares = 0.0;
+        for(int j = 0; j < numberOfPapers; j++)
+        {
+            if(j != i)
+            {
+                sum += distanceMatrix[i][j];
+                sumOfSquares += distanceMatrix[i][j] * distanceMatrix[i][j];
+            }
+        }
+        spread[i] = sumOfSquares - sum * sum / max(1, numberOfPapers - 1);
+    }
+
+    paperOrder.resize(numberOfPapers);
+    for(int i = 0; i < numberOfPapers; i++)
+        paperOrder[i] = i;
+    stable_sort(paperOrder.begin(), paperOrder.end(), [&spread](int a, int b) { return spread[a] > spread[b]; });
+
+    distances.resize(numberOfPapers * numberOfPapers);
+    for(int i = 0; i < numberOfPapers; i++)
+    {
+        for(int j = 0; j < numberOfPapers; j++)
+        {
+            distances[i * numberOfPapers + j] = distanceMatrix[paperOrder[i]][paperOrder[j]];
+        }
+    }
+}
+
+void ExactSolver::computePairBounds(int depth)
+{
+    lock_guard<mutex> lock(boundsMutex);
+    if(boundsBuilt[depth].load(memory_order_relaxed))
+        return;
+
+    largestSimilarities[depth].resize(numberOfPapers);
+    largestParallels[depth].resize(numberOfPapers);
+    largestPairs[depth].resize(numberOfPapers);
+
+    vector<double> similarities, parallels, best;
+    for(int paper = depth; paper < numberOfPapers; paper++)
+    {
+        similarities.clear();
+        parallels.clear();
+        best.clear();
+        for(int other = depth; other < numberOfPapers; other++)
+        {
+            if(other == paper)
+                continue;
+
+            double similarity = 1.0 - distances[paper * numberOfPapers + other];
+            double parallel = tradeoffCoefficient * distances[paper * numberOfPapers + other];
+            similarities.push_back(similarity);
+            parallels.push_back(parallel);
+            best.push_back(max(similarity, parallel));
+        }
+
+        largestSimilarities[depth][paper] = largestPrefixSums(similarities);
+        largestParallels[depth][paper] = largestPrefixSums(parallels);
+        largestPairs[depth][paper] = largestPrefixSums(best);
+    }
+
+    boundsBuilt[depth].store(true, memory_order_release);
+}
+
+double ExactSolver::getPairBound(int depth, int paper, int sessionMates, int parallelMates)
+{
+    int pairs = numberOfPapers - depth - 1;
+    sessionMates = min(sessionMates, pairs);
+    parallelMates = min(parallelMates, pairs);
+
+    double separateBound = largestSimilarities[depth][paper][sessionMates] + largestParallels[depth][paper][parallelMates];
+    double jointBound = largestPairs[depth][paper][min(sessionMates + parallelMates, pairs)];
+    return min(separateBound, jointBound);
+}
+
+void ExactSolver::initState(SearchState &state)
+{
+    state.sessionOfPaper.assign(numberOfPapers, -1);
+    state.papersInOpenSession.assign(numberOfSessions, 0);
+    state.sessionsOpenInSlot.assign(sessionsInTrack, 0);
+    state.papersInSlot.assign(sessionsInTrack, 0);
+    state.slotsOpen = 0;
+    state.score = 0.0;
+    state.sessionDistance.assign(numberOfPapers * numberOfSessions, 0.0);
+    state.slotDistance.assign(numberOfPapers * sessionsInTrack, 0.0);
+}
+
+void ExactSolver::getPlacements(SearchState &state, int depth, vector<int> &sessions, vector<double> &gains)
+{
+    sessions.clear();
+    gains.clear();
+
+    double *sessionDistance = &state.sessionDistance[depth * numberOfSessions];
+    double *slotDistance = &state.slotDistance[depth * sessionsInTrack];
+
+    for(int slot = 0; slot < state.slotsOpen; slot++)
+    {
+        int sessionsOpen = state.sessionsOpenInSlot[slot];
+        for(int j = 0; j < sessionsOpen; j++)
+        {
+            int session = slot * parallelTracks + j;
+            int papers = state.papersInOpenSession[session];
+            if(papers < papersInSession)
+            {
+                sessions.push_back(session);
+                gains.push_back(papers - sessionDistance[session] + tradeoffCoefficient * (slotDistance[slot] - sessionDistance[session]));
+            }
+        }
+
+        // the next session of the time slot
+        if(sessionsOpen < parallelTracks)
+        {
+            sessions.push_back(slot * parallelTracks + sessionsOpen);
+            gains.push_back(tradeoffCoefficient * slotDistance[slot]);
+        }
+    }
+
+    // the next time slot
+    if(state.slotsOpen < sessionsInTrack)
+    {
+        sessions.push_back(state.slotsOpen * parallelTracks);
+        gains.push_back(0.0);
+    }
+}
+
+void ExactSolver::placePaper(SearchState &state, int depth, int session, double gain)
+{
+    int slot = session / parallelTracks;
+    if(state.papersInOpenSession[session] == 0)
+    {
+        if(state.sessionsOpenInSlot[slot] == 0)
+            state.slotsOpen++;
+        state.sessionsOpenInSlot[slot]++;
+    }
+    state.papersInOpenSession[session]++;
+    state.papersInSlot[slot]++;
+    state.sessionOfPaper[depth] = session;
+    state.score += gain;
+
+    double *distances = &this->distances[depth * numberOfPapers];
+    for(int paper = depth + 1; paper < numberOfPapers; paper++)
+    {
+        state.sessionDistance[paper * numberOfSessions + session] += distances[paper];
+        state.slotDistance[paper * sessionsInTrack + slot] += distances[paper];
+    }
+}
+
+void ExactSolver::removePaper(SearchState &state, int depth, int session, double gain)
+{
+    int slot = session / parallelTracks;
+    state.papersInOpenSession[session]--;
+    state.papersInSlot[slot]--;
+    if(state.papersInOpenSession[session] == 0)
+    {
+        state.sessionsOpenInSlot[slot]--;
+        if(state.sessionsOpenInSlot[slot] == 0)
+            state.slotsOpen--;
+    }
+    state.sessionOfPaper[depth] = -1;
+    state.score -= gain;
+
+    double *distances = &this->distances[depth * numberOfPapers];
+    for(int paper = depth + 1; paper < numberOfPapers; paper++)
+    {
+        state.sessionDistance[paper * numberOfSessions + session] -= distances[paper];
+        state.slotDistance[paper * sessionsInTrack + slot] -= distances[paper];
+    }
+}
+
+double ExactSolver::getUpperBound(SearchState &state, int depth)
+{
+    // every unplaced paper gains at most its best placement among the placed
+    // papers, plus the bound on its pairs with the other unplaced papers for
+    // the mates it has left in that placement
+    int sessionMates = papersInSession - 1;
+    int parallelMates = (parallelTracks - 1) * papersInSession;
+    if(!boundsBuilt[depth].load(memory_order_acquire))
+        computePairBounds(depth);
+
+    double bound = state.score;
+    for(int paper = depth; paper < numberOfPapers; paper++)
+    {
+        double *sessionDistance = &state.sessionDistance[paper * numberOfSessions];
+        double *slotDistance = &state.slotDistance[paper * sessionsInTrack];
+
+        double best = -1e300;
+        for(int slot = 0; slot < state.slotsOpen; slot++)
+        {
+            int sessionsOpen = state.sessionsOpenInSlot[slot];
+            int papersInSlot = state.papersInSlot[slot];
+            for(int j = 0; j < sessionsOpen; j++)
+            {
+                int session = slot * parallelTracks + j;
+                int papers = state.papersInOpenSession[session];
+                if(papers < papersInSession)
+                {
+                    double gain = papers - sessionDistance[session] + tradeoffCoefficient * (slotDistance[slot] - sessionDistance[session]);
+                    best = max(best, gain + getPairBound(depth, paper, sessionMates - papers, parallelMates - (papersInSlot - papers)));
+                }
+            }
+
+            if(sessionsOpen < parallelTracks)
+            {
+                double gain = tradeoffCoefficient * slotDistance[slot];
+                best = max(best, gain + getPairBound(depth, paper, sessionMates, parallelMates - papersInSlot));
+            }
+        }
+
+        if(state.slotsOpen < sessionsInTrack)
+        {
+            best = max(best, getPairBound(depth, paper, sessionMates, parallelMates));
+        }
+
+        bound += best;
+    }
+    return bound;
+}
+
+void ExactSolver::search(SearchState &state, int depth, long long &nodesSinceCheck)
+{
+    if(timeUp)
+        return;
+
+    if(++nodesSinceCheck >= NODES_PER_TIME_CHECK)
+    {
+        numberOfNodes += nodesSinceCheck;
+        nodesSinceCheck = 0;
+        if(time(0) >= deadline)
+        {
+            timeUp = true;
+            return;
+        }
+    }
+
+    if(depth == numberOfPapers)
+    {
+        if(state.score > bestScore)
+        {
+            lock_guard<mutex> lock(bestMutex);
+            if(state.score > bestScore)
+            {
+                bestScore = state.score;
+                bestSessionOfPaper = state.sessionOfPaper;
+            }
+        }
+        return;
+    }
+
+    if(getUpperBound(state, depth) <= bestScore + SCORE_EPSILON)
+        return;
+
+    vector<int> sessions;
+    vector<double> gains;
+    getPlacements(state, depth, sessions, gains);
+
+    // most promising placement first
+    vector<int> order(sessions.size());
+    for(int i = 0; i < order.size(); i++)
+        order[i] = i;
+    sort(order.begin(), order.end(), [&gains](int a, int b) { return gains[a] > gains[b]; });
+
+    for(int i = 0; i < order.size(); i++)
+    {
+        placePaper(state, depth, sessions[order[i]], gains[order[i]]);
+        search(state, depth + 1, nodesSinceCheck);
+        removePaper(state, depth, sessions[order[i]], gains[order[i]]);
+    }
+}
+
+void ExactSolver::collectSubtrees(SearchState &state, int depth, int targetDepth, vector< vector<int> > &subtrees)
+{
+    if(depth == targetDepth)
+    {
+        subtrees.push_back(vector<int>(state.sessionOfPaper.begin(), state.sessionOfPaper.begin() + depth));
+        return;
+    }
+
+    vector<int> sessions;
+    vector<double> gains;
+    getPlacements(state, depth, sessions, gains);
+    for(int i = 0; i < sessions.size(); i++)
+    {
+        placePaper(state, depth, sessions[i], gains[i]);
+        collectSubtrees(state, depth + 1, targetDepth, subtrees);
+        removePaper(state, depth, sessions[i], gains[i]);
+    }
+}
+
+void ExactSolver::searchSubtrees(vector< vector<int> > *subtrees, atomic<int> *nextSubtree)
+{
+    SearchState state;
+    initState(state);
+
+    vector<int> sessions;
+    vector<double> gains;
+    long long nodesSinceCheck = 0;
+
+    for(int index = (*nextSubtree)++; index < subtrees->size() && !timeUp; index = (*nextSubtree)++)
+    {
+        vector<int> &prefix = (*subtrees)[index];
+
+        // replay the placements of the subtree root
+        for(int depth = 0; depth < prefix.size(); depth++)
+        {
+            getPlacements(state, depth, sessions, gains);
+            int option = find(sessions.begin(), sessions.end(), prefix[depth]) - sessions.begin();
+            placePaper(state, depth, prefix[depth], gains[option]);
+        }
+
+        search(state, prefix.size(), nodesSinceCheck);
+
+        initState(state);
+    }
+
+    numberOfNodes += nodesSinceCheck;
+}
+
+bool ExactSolver::solve(Conference &conference, double timeLimitInSeconds)
+{
+    bestScore = conference.getScore();
+    bestSessionOfPaper.clear();
+    deadline = time(0) + (time_t)max(1.0, timeLimitInSeconds);
+    timeUp = false;
+    numberOfNodes = 0;
+
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+
+    // split the tree deep enough to keep every thread busy
+    SearchState state;
+    initState(state);
+    vector< vector<int> > subtrees;
+    int targetDepth = 0;
+    do {
+        targetDepth++;
+        subtrees.clear();
+        collectSubtrees(state, 0, targetDepth, subtrees);
+    } while(subtrees.size() < 16 * numberOfThreads && targetDepth < numberOfPapers / 2);
+
+    atomic<int> nextSubtree(0);
+    vector<thread> threads;
+    for(int i = 0; i < numberOfThreads; i++)
+    {
+        threads.push_back(thread(&ExactSolver::searchSubtrees, this, &subtrees, &nextSubtree));
+    }
+    for(int i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    // write the best organization back
+    if(!bestSessionOfPaper.empty())
+    {
+        vector<int> papersPlaced(numberOfSessions, 0);
+        for(int paper = 0; paper < numberOfPapers; paper++)
+        {
+            int session = bestSessionOfPaper[paper];
+            int trackIndex = session % parallelTracks;
+            int sessionIndex = session / parallelTracks;
+            conference.setPaper(trackIndex, sessionIndex, papersPlaced[session]++, paperOrder[paper]);
+        }
+        conference.increaseScore(bestScore - conference.getScore());
+    }
+
+    return !timeUp;
+}
+
+long long ExactSolver::getNumberOfNodes()
+{
+    return numberOfNodes;
+}
@@ -0,0 +1,154 @@
+/*
+ * File:   Incumbent.cpp
+ *
+ */
+
+#include <limits>
+#include <thread>
+
+#include "Incumbent.h"
+
+Incumbent::Incumbent()
+{
+    bestScore = -numeric_limits<double>::max();
+    sequence = 0;
+    papers = NULL;
+    numberOfPapers = 0;
+    snapshotScore = -numeric_limits<double>::max();
+    version = 0;
+    notifiedVersion = 0;
+}
+
+Incumbent::~Incumbent()
+{
+    delete [] papers;
+}
+
+void Incumbent::init(const vector<int> &papers, double score)
+{
+    // the snapshot keeps its size from now on, so readers never see it moved
+    if(numberOfPapers != papers.size())
+    {
+        delete [] this->papers;
+        numberOfPapers = papers.size();
+        this->papers = new atomic<int>[numberOfPapers];
+    }
+    bestScore = score;
+    writeSnapshot(papers, score, false);
+    notifiedVersion = version.load();
+}
+
+void Incumbent::setListener(function<void(const vector<int>&, double)> listener)
+{
+    lock_guard<mutex> lock(listenerMutex);
+    this->listener = listener;
+}
+
+unsigned long long Incumbent::lockSnapshot()
+{
+    // take the lock by making the sequence number odd, only the takers of
+    // a new best score ever wait here
+    unsigned long long current = sequence.load(memory_order_relaxed);
+    while((current & 1) || !sequence.compare_exchange_weak(current, current + 1, memory_order_acquire))
+    {
+        this_thread::yield();
+        current = sequence.load(memory_order_relaxed);
+    }
+
+    // the odd sequence number is seen before any of the writes that follow
+    atomic_thread_fence(memory_order_release);
+    return current;
+}
+
+void Incumbent::writeSnapshot(const vector<int> &papers, double score, bool onlyIfBetter)
+{
+    unsigned long long current = lockSnapshot();
+
+    // a better schedule may have been written since the score was taken
+    if(!onlyIfBetter || score > snapshotScore.load(memory_order_relaxed))
+    {
+        for(int i = 0; i < numberOfPapers; i++)
+            this->papers[i].store(papers[i], memory_order_relaxed);
+        snapshotScore.store(score, memory_order_relaxed);
+        version.store(version.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    sequence.store(current + 2, memory_order_release);
+}
+
+void Incumbent::correctScore(const vector<int> &papers, double score)
+{
+    if(numberOfPapers != papers.size())
+        return;
+
+    unsigned long long current = lockSnapshot();
+    bool same = true;
+    for(int i = 0; i < numberOfPapers && same; i++)
+        same = this->papers[i].load(memory_order_relaxed) == papers[i];
+    if(same)
+    {
+        // the best score moves with the snapshot, unless an offer already beat it
+        double best = snapshotScore.load(memory_order_relaxed);
+        bestScore.compare_exchange_strong(best, score);
+        snapshotScore.store(score, memory_order_relaxed);
+    }
+    sequence.store(current + 2, memory_order_release);
+}
+
+bool Incumbent::offer(const vector<int> &papers, double score)
+{
+    double best = bestScore.load(memory_order_relaxed);
+    do
+    {
+        if(score <= best)
+            return false;
+    } while(!bestScore.compare_exchange_weak(best, score));
+
+    writeSnapshot(papers, score, true);
+    notifyListener();
+    return true;
+}
+
+long long Incumbent::read(vector<int> &papers, double &score)
+{
+    while(true)
+    {
+        unsigned long long current = sequence.load(memory_order_acquire);
+        if(current & 1)
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        papers.resize(numberOfPapers);
+        for(int i = 0; i < numberOfPapers; i++)
+            papers[i] = this->papers[i].load(memory_order_relaxed);
+        score = snapshotScore.load(memory_order_relaxed);
+        long long snapshotVersion = version.load(memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if(sequence.load(memory_order_relaxed) == current)
+            return snapshotVersion;
+    }
+}
+
+long long Incumbent::getVersion()
+{
+    return version.load();
+}
+
+void Incumbent::notifyListener()
+{
+    // the thread holding the lock checks the version again once done, so a
+    // snapshot taken meanwhile is not missed
+    while(notifiedVersion.load() != version.load() && listenerMutex.try_lock())
+    {
+        vector<int> schedule;
+        double score;
+        long long snapshotVersion = read(schedule, score);
+        if(listener)
+            listener(schedule, score);
+        notifiedVersion = snapshotVersion;
+        listenerMutex.unlock();
+    }
+}
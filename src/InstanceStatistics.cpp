@@ -0,0 +1,157 @@
+/*
+ * File:   InstanceStatistics.cpp
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "InstanceStatistics.h"
+#include "CompensatedSum.h"
+
+InstanceStatistics::InstanceStatistics()
+{
+    numberOfPapers = 0;
+    valid = false;
+    symmetric = false;
+    quantizationScale = 0;
+}
+
+unsigned long long InstanceStatistics::hashEntry(double distance, int position)
+{
+    // 0.0 and -0.0 are equal distances
+    unsigned long long bits = 0;
+    if(distance != 0.0)
+        memcpy(&bits, &distance, sizeof(bits));
+
+    // the finalizer of splitmix64
+    unsigned long long hash = bits + (unsigned long long)position * 0x9e3779b97f4a7c15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+void InstanceStatistics::init(int numberOfPapers, int numberOfThreads)
+{
+    this->numberOfPapers = numberOfPapers;
+    valid = false;
+    symmetric = false;
+    quantizationScale = 0;
+
+    rowSums.assign(numberOfPapers, 0.0);
+    rowMinimums.assign(numberOfPapers, 0.0);
+    rowMaximums.assign(numberOfPapers, 0.0);
+    rowFits8Bits.assign(numberOfPapers, 0);
+    rowFits16Bits.assign(numberOfPapers, 0);
+    rowHashes.assign(numberOfPapers, 0);
+    columnHashes.assign(max(1, numberOfThreads), vector<unsigned long long>(numberOfPapers, 0));
+}
+
+void InstanceStatistics::addRow(const double *distances, int paperId, int thread)
+{
+    unsigned long long *columns = &columnHashes[thread][0];
+    unsigned long long rowHash = 0;
+    CompensatedSum sum;
+    double minimum = numeric_limits<double>::max();
+    double maximum = -numeric_limits<double>::max();
+    bool fits8Bits = true;
+    bool fits16Bits = true;
+
+    for(int other = 0; other < numberOfPapers; other++)
+    {
+        double distance = distances[other];
+        sum.add(distance);
+        rowHash += hashEntry(distance, other);
+        columns[other] += hashEntry(distance, paperId);
+
+        if(other != paperId)
+        {
+            minimum = min(minimum, distance);
+            maximum = max(maximum, distance);
+        }
+
+        // the same test as QuantizedDistanceMatrix makes
+        double units = distance * 100;
+        if(units < -1e-6 || units > 255 + 1e-6 || fabs(units - floor(units + 0.5)) > 1e-6)
+            fits8Bits = false;
+        units = distance * 10000;
+        if(units < -1e-6 || units > 65535 + 1e-6 || fabs(units - floor(units + 0.5)) > 1e-6)
+            fits16Bits = false;
+    }
+
+    rowSums[paperId] = sum.getSum();
+    rowMinimums[paperId] = numberOfPapers > 1 ? minimum : 0.0;
+    rowMaximums[paperId] = numberOfPapers > 1 ? maximum : 0.0;
+    rowFits8Bits[paperId] = fits8Bits;
+    rowFits16Bits[paperId] = fits16Bits;
+    rowHashes[paperId] = rowHash;
+}
+
+void InstanceStatistics::finish()
+{
+    bool fits8Bits = true;
+    bool fits16Bits = true;
+    symmetric = true;
+    for(int paper = 0; paper < numberOfPapers; paper++)
+    {
+        unsigned long long columnHash = 0;
+        for(int t = 0; t < columnHashes.size(); t++)
+            columnHash += columnHashes[t][paper];
+        if(columnHash != rowHashes[paper])
+            symmetric = false;
+
+        fits8Bits = fits8Bits && rowFits8Bits[paper];
+        fits16Bits = fits16Bits && rowFits16Bits[paper];
+    }
+    quantizationScale = fits8Bits ? 100 : (fits16Bits ? 10000 : 0);
+
+    columnHashes.clear();
+    valid = true;
+}
+
+void InstanceStatistics::clear()
+{
+    valid = false;
+}
+
+bool InstanceStatistics::isValid()
+{
+    return valid;
+}
+
+bool InstanceStatistics::isSymmetric()
+{
+    return symmetric;
+}
+
+int InstanceStatistics::getQuantizationScale()
+{
+    return quantizationScale;
+}
+
+double InstanceStatistics::getRowSum(int paperId)
+{
+    return rowSums[paperId];
+}
+
+double InstanceStatistics::getMinimumDistance(int paperId)
+{
+    return rowMinimums[paperId];
+}
+
+double InstanceStatistics::getMaximumDistance(int paperId)
+{
+    return rowMaximums[paperId];
+}
+
+double InstanceStatistics::getMinimumDistance()
+{
+    return numberOfPapers > 0 ? *min_element(rowMinimums.begin(), rowMinimums.end()) : 0.0;
+}
+
+double InstanceStatistics::getMaximumDistance()
+{
+    return numberOfPapers > 0 ? *max_element(rowMaximums.begin(), rowMaximums.end()) : 0.0;
+}
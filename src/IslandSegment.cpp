@@ -0,0 +1,428 @@
+/*
+ * File:   IslandSegment.cpp
+ *
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "IslandSegment.h"
+
+// the number of elite schedules migrating between the islands
+#define ISLAND_ELITES 8
+
+// the largest number of islands attached to one segment
+#define ISLAND_MAXIMUM 64
+
+// the seconds a joining island waits for the creator to size the segment and
+// record itself, before the segment is taken as left behind
+#define CREATOR_START_SECONDS 10
+
+// attempts at taking or reading a sequence lock before giving up, in case
+// an island died while writing
+#define SEQUENCE_LOCK_ATTEMPTS 100000
+
+/**
+ * A schedule slot: odd sequence numbers mark a write in progress. The low 32
+ * bits of the sequence count the writes and the high 32 bits hold the process
+ * id of the writer while it writes, so the lock of a writer that was killed
+ * can be taken over. The fields are read while they may be written, so they
+ * and the papers are copied through relaxed atomics.
+ */
+struct ScheduleSlot {
+    atomic<unsigned long long> sequence;
+    atomic<double> score;
+    atomic<int> owner;  // process id of the writer, 0 for an empty slot
+};
+
+/**
+ * The header at the start of the segment. The incumbent, the elites and the
+ * distance matrix follow it.
+ */
+struct IslandSegmentHeader {
+    atomic<int> ready;
+    atomic<int> creator;    // process id of the island filling in the matrix
+    atomic<unsigned int> nextElite;
+
+    // process ids of the attached islands, 0 for a free entry
+    atomic<int> islands[ISLAND_MAXIMUM];
+
+    // the instance the segment was created for
+    int numberOfPapers;
+    double tradeoffCoefficient;
+    long long fileSize;
+    long long fileTime;
+    long long fileInode;
+
+    ScheduleSlot slots[ISLAND_ELITES + 1];
+};
+
+/**
+ * Offsets of the parts of the segment, each aligned to a cache line.
+ */
+static size_t alignUp(size_t offset)
+{
+    return (offset + 63) / 64 * 64;
+}
+
+static size_t getPapersOffset(int slot, int numberOfPapers)
+{
+    return alignUp(sizeof(IslandSegmentHeader)) + (size_t)slot * alignUp(sizeof(int) * numberOfPapers);
+}
+
+static size_t getDistancesOffset(int numberOfPapers)
+{
+    return getPapersOffset(ISLAND_ELITES + 1, numberOfPapers);
+}
+
+/**
+ * The sequence numbers of a slot while its writer writes and once it is done.
+ */
+static unsigned long long getLockedSequence(unsigned long long sequence, int pid)
+{
+    return ((unsigned long long)pid << 32) | ((sequence + 1) & 0xffffffffULL);
+}
+
+static unsigned long long getUnlockedSequence(unsigned long long sequence)
+{
+    return (sequence + 1) & 0xffffffffULL;
+}
+
+/**
+ * Check that a process is running, though it may belong to another user.
+ */
+static bool isAlive(int pid)
+{
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// the segment detached when the process exits, as the searches end with exit()
+static IslandSegment *attachedSegment = NULL;
+
+static void detachAtExit()
+{
+    if(attachedSegment != NULL)
+        attachedSegment->detach();
+}
+
+IslandSegment::IslandSegment()
+{
+    segment = NULL;
+    size = 0;
+    created = false;
+}
+
+IslandSegment::~IslandSegment()
+{
+    detach();
+}
+
+bool IslandSegment::attach(string name, string inputFileName, int numberOfPapers, double tradeoffCoefficient)
+{
+    struct stat fileStatus;
+    if(stat(inputFileName.c_str(), &fileStatus) != 0)
+        return false;
+
+    // shared memory names start with a slash
+    this->name = name[0] == '/' ? name : "/" + name;
+
+    // a segment left behind by islands that were killed is removed, and created again
+    bool stale = false;
+    if(open(fileStatus, numberOfPapers, tradeoffCoefficient, stale))
+        return true;
+    return stale && open(fileStatus, numberOfPapers, tradeoffCoefficient, stale);
+}
+
+/**
+ * Remove a segment by name, unless another island already replaced it.
+ */
+static void unlinkIfSame(const string &name, ino_t inode)
+{
+    int descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+    if(descriptor < 0)
+        return;
+
+    struct stat segmentStatus;
+    if(fstat(descriptor, &segmentStatus) == 0 && segmentStatus.st_ino == inode)
+        shm_unlink(name.c_str());
+    close(descriptor);
+}
+
+bool IslandSegment::open(const struct stat &fileStatus, int numberOfPapers, double tradeoffCoefficient, bool &stale)
+{
+    size = getDistancesOffset(numberOfPapers) + sizeof(double) * numberOfPapers * numberOfPapers;
+    stale = false;
+
+    struct stat segmentStatus;
+    memset(&segmentStatus, 0, sizeof(segmentStatus));
+    int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    created = descriptor >= 0;
+    if(created)
+    {
+        if(ftruncate(descriptor, size) != 0)
+        {
+            close(descriptor);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    }
+    else
+    {
+        descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+        if(descriptor < 0)
+            return false;
+
+        // the creator may not have sized the segment yet
+        bool sized = false;
+        for(int attempt = 0; attempt < CREATOR_START_SECONDS * 100 && fstat(descriptor, &segmentStatus) == 0; attempt++)
+        {
+            sized = segmentStatus.st_size > 0;
+            if(sized)
+                break;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        if(!sized || segmentStatus.st_size < (off_t)alignUp(sizeof(IslandSegmentHeader)))
+        {
+            close(descriptor);
+            stale = true;
+            unlinkIfSame(name, segmentStatus.st_ino);
+            return false;
+        }
+
+        // a segment of another instance is mapped whole, to read its header
+        size = segmentStatus.st_size;
+    }
+
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if(mapping == MAP_FAILED)
+    {
+        if(created)
+            shm_unlink(name.c_str());
+        return false;
+    }
+    segment = (IslandSegmentHeader*)mapping;
+
+    if(created)
+    {
+        // the new segment is zero filled, so every slot starts empty
+        segment->numberOfPapers = numberOfPapers;
+        segment->tradeoffCoefficient = tradeoffCoefficient;
+        segment->fileSize = fileStatus.st_size;
+        segment->fileTime = fileStatus.st_mtime;
+        segment->fileInode = fileStatus.st_ino;
+        segment->creator = getpid();
+    }
+    else if(!waitUntilReady() || size != getDistancesOffset(numberOfPapers) + sizeof(double) * numberOfPapers * numberOfPapers
+        || segment->numberOfPapers != numberOfPapers || segment->tradeoffCoefficient != tradeoffCoefficient
+        || segment->fileSize != fileStatus.st_size || segment->fileTime != fileStatus.st_mtime || segment->fileInode != (long long)fileStatus.st_ino)
+    {
+        // left unfilled by a creator that died, or for another instance by islands that all died
+        stale = segment->ready.load() == 0 || countIslands() == 0;
+        munmap(segment, size);
+        segment = NULL;
+        if(stale)
+            unlinkIfSame(name, segmentStatus.st_ino);
+        return false;
+    }
+
+    if(!addIsland())
+    {
+        munmap(segment, size);
+        segment = NULL;
+        if(created)
+            shm_unlink(name.c_str());
+        return false;
+    }
+
+    if(attachedSegment == NULL)
+    {
+        attachedSegment = this;
+        atexit(detachAtExit);
+    }
+    return true;
+}
+
+bool IslandSegment::addIsland()
+{
+    // the entry of an island that was killed is taken over
+    for(int i = 0; i < ISLAND_MAXIMUM; i++)
+    {
+        int pid = segment->islands[i].load();
+        if((pid == 0 || !isAlive(pid)) && segment->islands[i].compare_exchange_strong(pid, getpid()))
+            return true;
+    }
+    return false;
+}
+
+int IslandSegment::countIslands()
+{
+    int count = 0;
+    for(int i = 0; i < ISLAND_MAXIMUM; i++)
+    {
+        int pid = segment->islands[i].load();
+        if(pid == 0)
+            continue;
+
+        // islands that were killed never detached, their entries are freed here
+        if(!isAlive(pid))
+            segment->islands[i].compare_exchange_strong(pid, 0);
+        else
+            count++;
+    }
+    return count;
+}
+
+void IslandSegment::detach()
+{
+    if(segment == NULL)
+        return;
+
+    for(int i = 0; i < ISLAND_MAXIMUM; i++)
+    {
+        int pid = getpid();
+        segment->islands[i].compare_exchange_strong(pid, 0);
+    }
+    bool last = countIslands() == 0;
+    munmap(segment, size);
+    segment = NULL;
+
+    if(last)
+        shm_unlink(name.c_str());
+    if(attachedSegment == this)
+        attachedSegment = NULL;
+}
+
+bool IslandSegment::isAttached()
+{
+    return segment != NULL;
+}
+
+bool IslandSegment::isCreator()
+{
+    return segment != NULL && created;
+}
+
+bool IslandSegment::waitUntilReady()
+{
+    // the creator may parse a large input for long, it is waited for while it runs
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    while(segment->ready.load(memory_order_acquire) == 0)
+    {
+        int creator = segment->creator.load();
+        if(creator == 0 ? chrono::duration<double>(chrono::steady_clock::now() - start).count() > CREATOR_START_SECONDS : !isAlive(creator))
+            return false;
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return true;
+}
+
+void IslandSegment::setReady()
+{
+    segment->ready.store(1, memory_order_release);
+}
+
+double* IslandSegment::getDistances()
+{
+    return (double*)((char*)segment + getDistancesOffset(segment->numberOfPapers));
+}
+
+int IslandSegment::getNumberOfIslands()
+{
+    return segment == NULL ? 0 : countIslands();
+}
+
+bool IslandSegment::writeSlot(int slot, const vector<int> &papers, double score, bool onlyIfBetter)
+{
+    ScheduleSlot &scheduleSlot = segment->slots[slot + 1];
+    atomic<int> *slotPapers = (atomic<int>*)((char*)segment + getPapersOffset(slot + 1, segment->numberOfPapers));
+
+    // take the lock by making the sequence number odd
+    unsigned long long sequence = scheduleSlot.sequence.load(memory_order_relaxed);
+    bool takenOver = false;
+    int attempt = 0;
+    while((sequence & 1) || !scheduleSlot.sequence.compare_exchange_weak(sequence, getLockedSequence(sequence, getpid()), memory_order_acquire))
+    {
+        if(++attempt == SEQUENCE_LOCK_ATTEMPTS)
+        {
+            // a writer killed while writing left the slot locked, its lock is taken over
+            int writer = sequence >> 32;
+            if(!(sequence & 1) || isAlive(writer)
+                || !scheduleSlot.sequence.compare_exchange_strong(sequence, getLockedSequence(sequence + 1, getpid()), memory_order_acquire))
+                return false;
+            sequence = (sequence + 1) & 0xffffffffULL;
+            takenOver = true;
+            break;
+        }
+        sequence = scheduleSlot.sequence.load(memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_release);
+
+    // the half written schedule of a killed writer is overwritten in any case
+    bool write = takenOver || !onlyIfBetter || scheduleSlot.owner.load(memory_order_relaxed) == 0
+        || score > scheduleSlot.score.load(memory_order_relaxed);
+    if(write)
+    {
+        scheduleSlot.score.store(score, memory_order_relaxed);
+        scheduleSlot.owner.store(getpid(), memory_order_relaxed);
+        for(int i = 0; i < segment->numberOfPapers; i++)
+            slotPapers[i].store(papers[i], memory_order_relaxed);
+    }
+
+    scheduleSlot.sequence.store(getUnlockedSequence(sequence + 1), memory_order_release);
+    return write;
+}
+
+bool IslandSegment::readSlot(int slot, vector<int> &papers, double &score)
+{
+    ScheduleSlot &scheduleSlot = segment->slots[slot + 1];
+    atomic<int> *slotPapers = (atomic<int>*)((char*)segment + getPapersOffset(slot + 1, segment->numberOfPapers));
+    papers.resize(segment->numberOfPapers);
+
+    for(int attempt = 0; attempt < SEQUENCE_LOCK_ATTEMPTS; attempt++)
+    {
+        unsigned long long sequence = scheduleSlot.sequence.load(memory_order_acquire);
+        if(sequence & 1)
+            continue;
+
+        int owner = scheduleSlot.owner.load(memory_order_relaxed);
+        score = scheduleSlot.score.load(memory_order_relaxed);
+        for(int i = 0; i < segment->numberOfPapers; i++)
+            papers[i] = slotPapers[i].load(memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if(scheduleSlot.sequence.load(memory_order_relaxed) == sequence)
+            return owner != 0 && owner != getpid();
+    }
+    return false;
+}
+
+bool IslandSegment::publishIncumbent(const vector<int> &papers, double score)
+{
+    return segment != NULL && writeSlot(-1, papers, score, true);
+}
+
+bool IslandSegment::readIncumbent(vector<int> &papers, double &score)
+{
+    return segment != NULL && readSlot(-1, papers, score);
+}
+
+void IslandSegment::publishElite(const vector<int> &papers, double score)
+{
+    if(segment != NULL)
+        writeSlot(segment->nextElite++ % ISLAND_ELITES, papers, score, false);
+}
+
+bool IslandSegment::readElite(mt19937 &generator, vector<int> &papers, double &score)
+{
+    return segment != NULL && readSlot(generator() % ISLAND_ELITES, papers, score);
+}
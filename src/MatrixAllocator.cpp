@@ -0,0 +1,143 @@
+/*
+ * File:   MatrixAllocator.cpp
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+#include "MatrixAllocator.h"
+
+// huge pages are 2 MB, blocks using them are rounded up to a whole number
+#define HUGE_PAGE_SIZE (2UL << 20)
+
+// the largest NUMA node handled
+#define MAXIMUM_NODES 64
+
+bool MatrixAllocator::parsePolicy(string name, Policy &policy)
+{
+    if(name == "default")
+        policy = DEFAULT_PAGES;
+    else if(name == "thp")
+        policy = TRANSPARENT_HUGE_PAGES;
+    else if(name == "hugetlb")
+        policy = EXPLICIT_HUGE_PAGES;
+    else if(name == "interleave")
+        policy = INTERLEAVED_NODES;
+    else if(name == "replicate")
+        policy = REPLICATED_NODES;
+    else
+        return false;
+    return true;
+}
+
+const char* MatrixAllocator::getPolicyName(Policy policy)
+{
+    switch(policy)
+    {
+        case TRANSPARENT_HUGE_PAGES: return "thp";
+        case EXPLICIT_HUGE_PAGES: return "hugetlb";
+        case INTERLEAVED_NODES: return "interleave";
+        case REPLICATED_NODES: return "replicate";
+        default: return "default";
+    }
+}
+
+/**
+ * The size of the mapping of a block: whole huge pages unless the policy
+ * uses ordinary pages.
+ */
+static size_t getMappedSize(size_t size, MatrixAllocator::Policy policy)
+{
+    size_t pageSize = policy == MatrixAllocator::DEFAULT_PAGES ? (size_t)sysconf(_SC_PAGESIZE) : HUGE_PAGE_SIZE;
+    return (size + pageSize - 1) / pageSize * pageSize;
+}
+
+void* MatrixAllocator::allocate(size_t size, Policy policy, int node)
+{
+    if(size == 0)
+        return NULL;
+
+    size = getMappedSize(size, policy);
+
+    void *block = MAP_FAILED;
+    if(policy == EXPLICIT_HUGE_PAGES)
+    {
+        // the huge page pool may be empty, fall back to transparent huge pages
+        block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if(block == MAP_FAILED)
+    {
+        block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(block == MAP_FAILED)
+            return NULL;
+
+        if(policy != DEFAULT_PAGES)
+            madvise(block, size, MADV_HUGEPAGE);
+    }
+
+    // pages are placed on first touch, so the policy is set before any is written
+    int numberOfNodes = getNumberOfNodes();
+    if(numberOfNodes > 1 && (node >= 0 || policy == INTERLEAVED_NODES))
+    {
+        unsigned long nodeMask[MAXIMUM_NODES / (8 * sizeof(unsigned long))] = {0};
+        int mode = MPOL_INTERLEAVE;
+        if(node >= 0)
+        {
+            nodeMask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+            mode = MPOL_BIND;
+        }
+        else
+        {
+            for(int i = 0; i < numberOfNodes; i++)
+                nodeMask[i / (8 * sizeof(unsigned long))] |= 1UL << (i % (8 * sizeof(unsigned long)));
+        }
+        syscall(SYS_mbind, block, size, mode, nodeMask, (unsigned long)MAXIMUM_NODES, 0);
+    }
+    return block;
+}
+
+void MatrixAllocator::release(void *block, size_t size, Policy policy)
+{
+    if(block == NULL)
+        return;
+
+    munmap(block, getMappedSize(size, policy));
+}
+
+int MatrixAllocator::getNumberOfNodes()
+{
+    static int numberOfNodes = 0;
+    if(numberOfNodes > 0)
+        return numberOfNodes;
+
+    // the online nodes are listed as ranges, "0-1" on a two socket machine
+    int lastNode = 0;
+    ifstream online("/sys/devices/system/node/online");
+    string ranges;
+    if(online >> ranges)
+    {
+        size_t position = ranges.find_last_of("-,");
+        lastNode = atoi(ranges.c_str() + (position == string::npos ? 0 : position + 1));
+    }
+    numberOfNodes = max(1, min(lastNode + 1, MAXIMUM_NODES));
+    return numberOfNodes;
+}
+
+int MatrixAllocator::getCurrentNode()
+{
+    static thread_local int currentNode = -1;
+    if(currentNode < 0)
+    {
+        unsigned int cpu = 0, node = 0;
+        if(syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+            node = 0;
+        currentNode = (int)node % getNumberOfNodes();
+    }
+    return currentNode;
+}
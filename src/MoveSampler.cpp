@@ -0,0 +1,38 @@
+/*
+ * File:   MoveSampler.cpp
+ *
+ */
+
+#include "MoveSampler.h"
+
+MoveSampler::MoveSampler(double swapShare, double rotationShare, double ejectionChainShare)
+{
+    shares[SWAP_MOVE] = swapShare;
+    shares[ROTATION_MOVE] = rotationShare;
+    shares[EJECTION_CHAIN_MOVE] = ejectionChainShare;
+
+    for(int i = 0; i < NUMBER_OF_MOVE_TYPES; i++)
+    {
+        spentSeconds[i] = 0.0;
+    }
+}
+
+MoveSampler::MoveType MoveSampler::nextMove()
+{
+    int best = SWAP_MOVE;
+    for(int i = 0; i < NUMBER_OF_MOVE_TYPES; i++)
+    {
+        if(shares[i] <= 0.0)
+            continue;
+
+        // time spent relative to the share, the lowest is furthest behind
+        if(shares[best] <= 0.0 || spentSeconds[i] * shares[best] < spentSeconds[best] * shares[i])
+            best = i;
+    }
+    return (MoveType)best;
+}
+
+void MoveSampler::recordMove(MoveType move, double seconds)
+{
+    spentSeconds[move] += seconds;
+}
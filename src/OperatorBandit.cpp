@@ -0,0 +1,89 @@
+/*
+ * File:   OperatorBandit.cpp
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "OperatorBandit.h"
+
+OperatorBandit::OperatorBandit(int numberOfOperators, int windowSize, double exploration)
+    : plays(numberOfOperators, 0), rewardSums(numberOfOperators, 0.0),
+      totalPlays(numberOfOperators, 0), totalGains(numberOfOperators, 0.0), totalMicroseconds(numberOfOperators, 0.0)
+{
+    this->numberOfOperators = numberOfOperators;
+    this->windowSize = windowSize;
+    this->exploration = exploration;
+}
+
+int OperatorBandit::nextOperator()
+{
+    for(int i = 0; i < numberOfOperators; i++)
+    {
+        if(plays[i] == 0)
+            return i;
+    }
+
+    // rewards are in score per microsecond, they are scaled by the largest
+    // reward in the window so that the confidence term has a fixed weight
+    double largestReward = 0.0;
+    for(int i = 0; i < rewards.size(); i++)
+    {
+        if(rewards[i] > largestReward)
+            largestReward = rewards[i];
+    }
+
+    double logPlays = log((double)playedOperators.size());
+    int best = 0;
+    double bestBound = -1.0;
+    for(int i = 0; i < numberOfOperators; i++)
+    {
+        double mean = rewardSums[i] / plays[i];
+        if(largestReward > 0.0)
+            mean /= largestReward;
+
+        double bound = mean + exploration * sqrt(logPlays / plays[i]);
+        if(bound > bestBound)
+        {
+            bestBound = bound;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void OperatorBandit::recordOperator(int op, double gain, double microseconds)
+{
+    double reward = gain > 0.0 ? gain / max(microseconds, 1.0) : 0.0;
+
+    playedOperators.push_back(op);
+    rewards.push_back(reward);
+    plays[op]++;
+    rewardSums[op] += reward;
+
+    if(playedOperators.size() > windowSize)
+    {
+        int oldest = playedOperators.front();
+        plays[oldest]--;
+        rewardSums[oldest] -= rewards.front();
+        if(plays[oldest] == 0)
+            rewardSums[oldest] = 0.0;
+        playedOperators.pop_front();
+        rewards.pop_front();
+    }
+
+    totalPlays[op]++;
+    totalGains[op] += max(gain, 0.0);
+    totalMicroseconds[op] += microseconds;
+}
+
+long long OperatorBandit::getTotalPlays(int op)
+{
+    return totalPlays[op];
+}
+
+double OperatorBandit::getGainRate(int op)
+{
+    return totalMicroseconds[op] > 0.0 ? totalGains[op] / totalMicroseconds[op] : 0.0;
+}
@@ -0,0 +1,169 @@
+/*
+ * File:   QuantizedDistanceMatrix.cpp
+ *
+ */
+
+#include <cmath>
+
+#include "QuantizedDistanceMatrix.h"
+
+QuantizedDistanceMatrix::QuantizedDistanceMatrix()
+{
+    numberOfPapers = 0;
+    scale = 0;
+    bits = 0;
+    size = 0;
+    policy = MatrixAllocator::DEFAULT_PAGES;
+}
+
+QuantizedDistanceMatrix::~QuantizedDistanceMatrix()
+{
+    clear();
+}
+
+void QuantizedDistanceMatrix::clear()
+{
+    for(int i = 0; i < copies.size(); i++)
+    {
+        MatrixAllocator::release(copies[i], size, policy);
+    }
+    copies.clear();
+    scale = 0;
+    bits = 0;
+    size = 0;
+}
+
+bool QuantizedDistanceMatrix::fits(double **distanceMatrix, int numberOfPapers, int scale, int maximum)
+{
+    for(int i = 0; i < numberOfPapers; i++)
+    {
+        for(int j = 0; j < numberOfPapers; j++)
+        {
+            double units = distanceMatrix[i][j] * scale;
+            if(units < -1e-6 || units > maximum + 1e-6 || fabs(units - floor(units + 0.5)) > 1e-6)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool QuantizedDistanceMatrix::build(double **distanceMatrix, int numberOfPapers, MatrixAllocator::Policy policy)
+{
+    int scale = 0;
+    if(fits(distanceMatrix, numberOfPapers, 100, 255))
+        scale = 100;
+    else if(fits(distanceMatrix, numberOfPapers, 10000, 65535))
+        scale = 10000;
+    return build(distanceMatrix, numberOfPapers, policy, scale);
+}
+
+bool QuantizedDistanceMatrix::build(double **distanceMatrix, int numberOfPapers, MatrixAllocator::Policy policy, int scale)
+{
+    clear();
+    this->numberOfPapers = numberOfPapers;
+    this->policy = policy;
+
+    if(scale == 100)
+    {
+        this->scale = 100;
+        bits = 8;
+    }
+    else if(scale == 10000)
+    {
+        this->scale = 10000;
+        bits = 16;
+    }
+    else
+    {
+        return false;
+    }
+
+    // the swap batches gather four bytes at a distance, the last one included
+    size = (size_t)numberOfPapers * numberOfPapers * (bits / 8) + sizeof(int);
+    if(policy == MatrixAllocator::REPLICATED_NODES)
+    {
+        for(int node = 0; node < MatrixAllocator::getNumberOfNodes(); node++)
+            copies.push_back(MatrixAllocator::allocate(size, policy, node));
+    }
+    else
+    {
+        copies.push_back(MatrixAllocator::allocate(size, policy));
+    }
+
+    for(int i = 0; i < copies.size(); i++)
+    {
+        if(copies[i] == NULL)
+        {
+            clear();
+            return false;
+        }
+    }
+
+    for(int i = 0; i < numberOfPapers; i++)
+    {
+        for(int j = 0; j < numberOfPapers; j++)
+        {
+            setDistance(i, j, distanceMatrix[i][j]);
+        }
+    }
+    return true;
+}
+
+int QuantizedDistanceMatrix::getScale()
+{
+    return scale;
+}
+
+int QuantizedDistanceMatrix::getBits()
+{
+    return bits;
+}
+
+bool QuantizedDistanceMatrix::canHold(double distance)
+{
+    int maximum = bits == 8 ? 255 : 65535;
+    double units = distance * scale;
+    return units >= -1e-6 && units <= maximum + 1e-6 && fabs(units - floor(units + 0.5)) <= 1e-6;
+}
+
+int QuantizedDistanceMatrix::setDistance(int paper1, int paper2, double distance)
+{
+    int maximum = bits == 8 ? 255 : 65535;
+    long long units = (long long)floor(distance * scale + 0.5);
+    units = units < 0 ? 0 : (units > maximum ? maximum : units);
+
+    size_t index = (size_t)paper1 * numberOfPapers + paper2;
+    for(int i = 0; i < copies.size(); i++)
+    {
+        if(bits == 8)
+            ((unsigned char*)copies[i])[index] = (unsigned char)units;
+        else
+            ((unsigned short*)copies[i])[index] = (unsigned short)units;
+    }
+    return (int)units;
+}
+
+void QuantizedDistanceMatrix::selectKernels(int papersInSession)
+{
+    kernels8.select(papersInSession);
+    kernels16.select(papersInSession);
+}
+
+long long QuantizedDistanceMatrix::getSimilarityUnits(const int *papers, int numberOfPapers)
+{
+    long long sum;
+    if(bits == 8)
+        sum = kernels8.sumPairs(QuantizedRows<unsigned char>((const unsigned char*)getLocalCopy(), this->numberOfPapers), papers, numberOfPapers);
+    else
+        sum = kernels16.sumPairs(QuantizedRows<unsigned short>((const unsigned short*)getLocalCopy(), this->numberOfPapers), papers, numberOfPapers);
+
+    long long pairs = (long long)numberOfPapers * (numberOfPapers - 1) / 2;
+    return pairs * scale - sum;
+}
+
+long long QuantizedDistanceMatrix::getParallelUnits(const int *papers1, int numberOfPapers1, const int *papers2, int numberOfPapers2)
+{
+    if(bits == 8)
+        return kernels8.sumCross(QuantizedRows<unsigned char>((const unsigned char*)getLocalCopy(), numberOfPapers), papers1, numberOfPapers1, papers2, numberOfPapers2);
+    return kernels16.sumCross(QuantizedRows<unsigned short>((const unsigned short*)getLocalCopy(), numberOfPapers), papers1, numberOfPapers1, papers2, numberOfPapers2);
+}
@@ -0,0 +1,106 @@
+/*
+ * File:   ScheduleConstraints.cpp
+ *
+ */
+
+#include "ScheduleConstraints.h"
+
+ScheduleConstraints::ScheduleConstraints()
+{
+    numberOfPapers = 0;
+    sessionsInTrack = 0;
+    wordsPerPaper = 0;
+    numberOfConstraints = 0;
+}
+
+void ScheduleConstraints::init(int numberOfPapers, int sessionsInTrack)
+{
+    this->numberOfPapers = numberOfPapers;
+    this->sessionsInTrack = sessionsInTrack;
+    this->wordsPerPaper = (sessionsInTrack + 63) / 64;
+    this->numberOfConstraints = 0;
+
+    constrained.assign(numberOfPapers, 0);
+    constrainedPapers.clear();
+    constrainedIndexes.assign(numberOfPapers, -1);
+    slotMasks.assign((size_t)numberOfPapers * wordsPerPaper, ~0ULL);
+    pinned.assign(numberOfPapers, false);
+    conflicts.assign(numberOfPapers, vector<int>());
+    apart.assign(numberOfPapers, vector<int>());
+    conflictPairs.clear();
+    apartPairs.clear();
+}
+
+void ScheduleConstraints::markConstrained(int paperId)
+{
+    if(!constrained[paperId])
+    {
+        constrained[paperId] = 1;
+        constrainedIndexes[paperId] = constrainedPapers.size();
+        constrainedPapers.push_back(paperId);
+    }
+}
+
+bool ScheduleConstraints::addConflict(int paper1, int paper2)
+{
+    if(paper1 < 0 || paper2 < 0 || paper1 >= numberOfPapers || paper2 >= numberOfPapers || paper1 == paper2)
+        return false;
+
+    if(conflictPairs.insert(getPairKey(paper1, paper2)).second)
+    {
+        conflictPairs.insert(getPairKey(paper2, paper1));
+        conflicts[paper1].push_back(paper2);
+        conflicts[paper2].push_back(paper1);
+    }
+    markConstrained(paper1);
+    markConstrained(paper2);
+    numberOfConstraints++;
+    return true;
+}
+
+bool ScheduleConstraints::addPin(int paperId, int sessionIndex)
+{
+    if(paperId < 0 || paperId >= numberOfPapers || sessionIndex < 0 || sessionIndex >= sessionsInTrack)
+        return false;
+
+    // the first pin of a paper clears the time slots it may take
+    unsigned long long *mask = &slotMasks[(size_t)paperId * wordsPerPaper];
+    if(!pinned[paperId])
+    {
+        for(int i = 0; i < wordsPerPaper; i++)
+            mask[i] = 0;
+        pinned[paperId] = true;
+    }
+    mask[sessionIndex / 64] |= 1ULL << (sessionIndex % 64);
+
+    markConstrained(paperId);
+    numberOfConstraints++;
+    return true;
+}
+
+bool ScheduleConstraints::addApart(int paper1, int paper2)
+{
+    if(paper1 < 0 || paper2 < 0 || paper1 >= numberOfPapers || paper2 >= numberOfPapers || paper1 == paper2)
+        return false;
+
+    if(apartPairs.insert(getPairKey(paper1, paper2)).second)
+    {
+        apartPairs.insert(getPairKey(paper2, paper1));
+        apart[paper1].push_back(paper2);
+        apart[paper2].push_back(paper1);
+    }
+    markConstrained(paper1);
+    markConstrained(paper2);
+    numberOfConstraints++;
+    return true;
+}
+
+int ScheduleConstraints::getNumberOfConstraints()
+{
+    return numberOfConstraints;
+}
+
+const vector<int>& ScheduleConstraints::getConstrainedPapers()
+{
+    return constrainedPapers;
+}
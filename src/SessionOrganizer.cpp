@@ -1,662 +1,3685 @@
-/* 
- * File:   SessionOrganizer.cpp
- * Author: Harishchandra Patidar
- * 
- */
-
-#include <algorithm> // for std::random_shuffle
-#include <map>
-#include <vector>
-#include <limits.h>
-
-#include "SessionOrganizer.h"
-#include "Util.h"
-
-
-SessionOrganizer::SessionOrganizer() : conference(NULL)
-{
-	parallelTracks = 0;
-	papersInSession = 0;
-	sessionsInTrack = 0;
-	processingTimeInMinutes = 0;
-	tradeoffCoefficient = 1.0;
-	outputFileName = "output.txt";
-	globalMaximumScore = 0.0;
-}
-
-SessionOrganizer::SessionOrganizer(string inputFileName, string outputFileName, time_t starting_time)
-{
-	this->outputFileName = outputFileName;
-	this->starting_time = starting_time;
-	readInInputFile(inputFileName);
-	conference = new Conference(parallelTracks, sessionsInTrack, papersInSession);
-}
-
-void SessionOrganizer::readInInputFile(string filename)
-{
-	vector<string> lines;
-	string line;
-	ifstream myfile(filename.c_str());
-	if(myfile.is_open())
-	{
-		while(getline(myfile, line))
-		{
-			//cout<<"Line read:"<<line<<endl;
-			lines.push_back(line);
-		}
-		myfile.close();
-	}
-	else
-	{
-		cout << "Unable to open input file" << endl;
-		exit(0);
-	}
-
-	if (6 > lines.size())
-	{
-		cout << "Not enough information given, check format of input file";
-		exit(0);
-	}
-
-	processingTimeInMinutes = atof(lines[0].c_str());
-	papersInSession = atoi(lines[1].c_str());
-	parallelTracks = atoi(lines[2].c_str());
-	sessionsInTrack = atoi(lines[3].c_str());
-	tradeoffCoefficient = atof(lines[4].c_str());
-
-	
-	int n = lines.size() - 5;
-	double ** tempDistanceMatrix = new double*[n];
-	for(int i = 0; i < n; ++i)
-	{
-		tempDistanceMatrix[i] = new double[n];
-	}
-
-
-	for(int i = 0; i < n; i++)
-	{
-		string tempLine = lines[i+5];
-		string elements[n];
-		splitString(tempLine, " ", elements, n);
-		
-		for(int j = 0; j < n; j++)
-		{
-			tempDistanceMatrix[i][j] = atof(elements[j].c_str());
-		}
-	}
-	distanceMatrix = tempDistanceMatrix;
-
-	int numberOfPapers = n;
-	int slots = parallelTracks * papersInSession*sessionsInTrack;
-	if(slots != numberOfPapers)
-	{
-		cout << "More papers than slots available! slots:" << slots << " num papers:" << numberOfPapers << endl;
-		exit(0);
-	}
-}
-
-double** SessionOrganizer::getDistanceMatrix()
-{
-	return distanceMatrix;
-}
-
-double SessionOrganizer::getSimilarityScoreForSession(Conference &conference, int trackIndex, int sessionIndex)
-{
-	double score = 0.0;
-	Session *session = conference.getSession(trackIndex,sessionIndex);
-
-	for(int i=0; i<session->getNumberOfPapers(); i++)
-	{
-		int paper1 = session->getPaper(i);
-		for(int j=i+1; j<session->getNumberOfPapers(); j++)
-		{
-			int paper2 = session->getPaper(j);
-			score += 1.0 - distanceMatrix[paper1][paper2];
-		}
-	}
-
-	return score;
-}
-
-double SessionOrganizer::getParallelScoreBetweenSessions(Conference &conference, int trackIndex1, int sessionIndex1, int trackIndex2, int sessionIndex2)
-{
-	double score = 0.0;
-
-	Session *session1 = conference.getSession(trackIndex1, sessionIndex1);
-	Session *session2 = conference.getSession(trackIndex2, sessionIndex2);
-
-	for(int paperIndex1 = 0; paperIndex1 < session1->getNumberOfPapers(); paperIndex1++)
-	{
-		int paper1 = session1->getPaper(paperIndex1);
-		for(int paperIndex2 = 0; paperIndex2 < session2->getNumberOfPapers(); paperIndex2++)
-		{
-			int paper2 = session2->getPaper(paperIndex2);
-			score += distanceMatrix[paper1][paper2];
-		}
-	}
-
-	return score;
-}
-
-double SessionOrganizer::getParallelScoreForSession(Conference &conference, int trackIndex, int sessionIndex)
-{
-	double score = 0.0;
-
-	for(int trackIndex2 = 0; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
-	{
-		if(trackIndex2 != trackIndex){
-			score += this->getParallelScoreBetweenSessions(conference,trackIndex,sessionIndex,trackIndex2,sessionIndex);
-		}
-	}
-
-	return score;
-}
-
-double SessionOrganizer::scoreConference(Conference &conference)
-{
-	// Sum of pairwise similarities per session.
-	double score1 = 0.0;
-	for(int trackIndex = 0; trackIndex < conference.getParallelTracks(); trackIndex++)
-	{
-		Track *tmpTrack = conference.getTrack(trackIndex);
-		for(int sessionIndex = 0; sessionIndex < tmpTrack->getNumberOfSessions(); sessionIndex++)
-		{
-			score1 += getSimilarityScoreForSession(conference, trackIndex, sessionIndex);
-		}
-	}
-
-	// Sum of distances for competing papers.
-	double score2 = 0.0;
-	for(int trackIndex1 = 0; trackIndex1 < conference.getParallelTracks(); trackIndex1++)
-	{
-		for(int sessionIndex1 = 0; sessionIndex1 < conference.getSessionsInTrack(); sessionIndex1++)
-		{
-			for(int trackIndex2 = trackIndex1 + 1; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
-			{
-				score2 += this->getParallelScoreBetweenSessions(conference,trackIndex1,sessionIndex1,trackIndex2,sessionIndex1);
-			}
-		}
-	}
-
-	double score = score1 + tradeoffCoefficient*score2;
-	conference.increaseScore(score - conference.getScore());
-
-	return score;
-}
-
-void SessionOrganizer::printSessionOrganiser()
-{
-	conference->printConference();
-}
-
-double SessionOrganizer::getConferenceScore()
-{
-	return conference->getScore();
-}
-
-void SessionOrganizer::initializeOrganization(Conference *conference)
-{
-	
-	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
-
-	vector<int> v;
-	for(int i=0; i<totalNumberOfPapers; i++){
-		v.push_back(i);
-	}
-
-	std::random_shuffle(v.begin(),v.end());
-
-	int paperCounter = 0;
-	for(int i = 0; i < conference->getSessionsInTrack(); i++)
-	{
-		for(int j = 0; j < conference->getParallelTracks(); j++)
-		{
-			for(int k = 0; k < conference->getPapersInSession(); k++)
-			{
-				conference->setPaper(j, i, k, v[paperCounter]);
-				paperCounter++;
-			}
-		}
-	}
-
-	// update the score
-	double score = scoreConference(*conference);
-}
-
-void SessionOrganizer::swapPapers(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
-{
-	int paper1 = conference.getPaper(trackIndex1, sessionIndex1, paperIndex1);
-	int paper2 = conference.getPaper(trackIndex2, sessionIndex2, paperIndex2);
-	
-	double delta = 0.0;
-	delta -= getSimilarityScoreForSession(conference, trackIndex1, sessionIndex1);
-	delta -= getSimilarityScoreForSession(conference, trackIndex2, sessionIndex2);
-	delta -= tradeoffCoefficient * getParallelScoreForSession(conference, trackIndex1, sessionIndex1);
-	delta -= tradeoffCoefficient * getParallelScoreForSession(conference, trackIndex2, sessionIndex2);
-
-	if(sessionIndex1 == sessionIndex2)
-	{
-		delta += tradeoffCoefficient * getParallelScoreBetweenSessions(conference, trackIndex1, sessionIndex1, trackIndex2, sessionIndex2);
-	}
-
-	conference.setPaper(trackIndex1,sessionIndex1,paperIndex1,paper2);
-	conference.setPaper(trackIndex2,sessionIndex2,paperIndex2,paper1);
-
-	delta += getSimilarityScoreForSession(conference, trackIndex1, sessionIndex1);
-	delta += getSimilarityScoreForSession(conference, trackIndex2, sessionIndex2);
-	delta += tradeoffCoefficient * getParallelScoreForSession(conference, trackIndex1, sessionIndex1);
-	delta += tradeoffCoefficient * getParallelScoreForSession(conference, trackIndex2, sessionIndex2);
-	
-	if(sessionIndex1 == sessionIndex2)
-	{
-		delta -= tradeoffCoefficient * getParallelScoreBetweenSessions(conference, trackIndex1, sessionIndex1, trackIndex2, sessionIndex2);
-	}
-
-	conference.increaseScore(delta);
-}
-
-void SessionOrganizer::swapTwoRandomPapers(Conference *conference) {
-	
-	int trackIndex1 = rand() % parallelTracks ;
-	int trackIndex2 = rand() % parallelTracks ;
-
-	int sessionIndex1 = rand() % sessionsInTrack;
-	int sessionIndex2 = rand() % sessionsInTrack;
-
-	if(trackIndex1 == trackIndex2) {
-		// sessions must be different if both tracks are same
-		if(sessionIndex1 == sessionIndex2) {
-			if(sessionsInTrack == 1) {
-				// change the track
-				do { 
-					trackIndex2 = rand() % parallelTracks;
-				} while (trackIndex1 == trackIndex2);
-			}else {
-				// change the session
-				do {
-					sessionIndex2 = rand() % sessionsInTrack;
-				} while (sessionIndex1 == sessionIndex2);
-			}
-		}
-	}
-
-	int paperIndex1 = rand() % papersInSession;
-	int paperIndex2 = rand() % papersInSession;
-
-	swapPapers(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
-}
-
-double SessionOrganizer::getScoreOnSwapping(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
-{
-	// first swap papers
-	swapPapers(conference,trackIndex1,sessionIndex1,paperIndex1,trackIndex2,sessionIndex2,paperIndex2);
-	
-	// calculate the resulting score
-	double score = conference.getScore();
-	
-	// now unswap
-	swapPapers(conference,trackIndex1,sessionIndex1,paperIndex1,trackIndex2,sessionIndex2,paperIndex2);
-	
-	return score;
-}
-
-bool SessionOrganizer::greedyStep()
-{
-	double currentMaximumScore = conference->getScore();
-	//cout<<"Current Score = "<<currentMaximumScore<<endl;
-	bool increased = false;
-	int optimalTrackIndex1,optimalTrackIndex2;
-	int optimalSessionIndex1,optimalSessionIndex2;
-	int optimalPaperIndex1,optimalPaperIndex2;
-
-	for(int trackIndex1=0; trackIndex1<parallelTracks; ++trackIndex1)
-	{
-
-		for(int sessionIndex1=0; sessionIndex1<sessionsInTrack; ++sessionIndex1)
-		{
-			
-			for(int trackIndex2=trackIndex1; trackIndex2<parallelTracks; ++trackIndex2)
-			{
-				
-				int sessionIndex2;
-				if(trackIndex1 == trackIndex2){
-					sessionIndex2 = sessionIndex1 + 1;
-				}else{
-					sessionIndex2 = 0;
-				}
-
-				for(sessionIndex2 ; sessionIndex2<sessionsInTrack; ++sessionIndex2)
-				{
-					
-					for(int paperIndex1=0; paperIndex1<papersInSession; ++paperIndex1){
-						int index1 = paperIndex1;
-						//int index1 = rand() % papersInSession;
-						int index2 = rand() % papersInSession;
-
-						//for(int index2 = 0; index2<papersInSession; index2++){
-							double newScore = getScoreOnSwapping(*conference,trackIndex1,sessionIndex1,index1,trackIndex2,sessionIndex2,index2);
-							//cout<<"New Score = "<<newScore<<endl;
-							if(newScore > currentMaximumScore) {
-								// save indexes
-								increased = true;
-								currentMaximumScore = newScore;
-								optimalTrackIndex1 = trackIndex1; optimalTrackIndex2 = trackIndex2;
-								optimalSessionIndex1 = sessionIndex1; optimalSessionIndex2 = sessionIndex2;
-								optimalPaperIndex1 = index1; optimalPaperIndex2 = index2;
-							}
-						//}
-					}
-				}
-			}
-		}
-	}
-
-	if(increased){
-		swapPapers(*conference,optimalTrackIndex1,optimalSessionIndex1,optimalPaperIndex1,optimalTrackIndex2,optimalSessionIndex2,optimalPaperIndex2);
-		//cout << conference->getScore() << endl;
-	}else{
-		;//cout<<"Reached Local Maxima"<<endl;
-	}
-
-	return increased;
-}
-
-/*
- * Swap papers only in time slot
- */
-bool SessionOrganizer::greedyStep2()
-{
-	double currentMaximumScore = conference->getScore();
-	//cout<<"Current Score = "<<currentMaximumScore<<endl;
-	bool increased = false;
-	int optimalTrackIndex1,optimalTrackIndex2;
-	int optimalSessionIndex1;
-	int optimalPaperIndex1,optimalPaperIndex2;
-
-	for(int sessionIndex1=0; sessionIndex1<sessionsInTrack; ++sessionIndex1)
-	{
-		for(int trackIndex1=0; trackIndex1<parallelTracks; ++trackIndex1)
-		{
-
-			for(int trackIndex2=trackIndex1+1; trackIndex2<parallelTracks; ++trackIndex2)
-			{
-
-				for(int paperIndex1=0; paperIndex1<papersInSession; ++paperIndex1){
-					int index1 = paperIndex1;
-
-					for(int index2 = 0; index2<papersInSession; index2++){
-						double newScore = getScoreOnSwapping(*conference,trackIndex1,sessionIndex1,index1,trackIndex2,sessionIndex1,index2);
-						
-						if(newScore > currentMaximumScore) {
-							// save indexes
-							increased = true;
-							currentMaximumScore = newScore;
-							optimalTrackIndex1 = trackIndex1; optimalTrackIndex2 = trackIndex2;
-							optimalSessionIndex1 = sessionIndex1;
-							optimalPaperIndex1 = index1; optimalPaperIndex2 = index2;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	if(increased){
-		swapPapers(*conference,optimalTrackIndex1,optimalSessionIndex1,optimalPaperIndex1,optimalTrackIndex2,optimalSessionIndex1,optimalPaperIndex2);
-	}else{
-		;//cout<<"Reached Local Maxima"<<endl;
-	}
-
-	return increased;
-}
-
-void SessionOrganizer::randomSwapping(int maximumIterations){
-
-	double maximumScore = conference->getScore();
-	int iterations = 0;
-
-	for(; iterations < maximumIterations ; iterations++){
-		int trackIndex1 = rand() % parallelTracks ;
-		int trackIndex2 = rand() % parallelTracks ;
-
-		int sessionIndex1 = rand() % sessionsInTrack;
-		int sessionIndex2 = rand() % sessionsInTrack;
-
-		if(trackIndex1 == trackIndex2) {
-			// sessions must be different if both tracks are same
-			if(sessionIndex1 == sessionIndex2) {
-				if(sessionsInTrack == 1) {
-					// change the track
-					do { 
-						trackIndex2 = rand() % parallelTracks;
-					} while (trackIndex1 == trackIndex2);
-				}else {
-					// change the session
-					do {
-						sessionIndex2 = rand() % sessionsInTrack;
-					} while (sessionIndex1 == sessionIndex2);
-				}
-			}
-		}
-
-		int paperIndex1 = rand() % papersInSession;
-		int paperIndex2 = rand() % papersInSession;
-
-		double score = getScoreOnSwapping(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
-
-		if(score > maximumScore){
-			iterations = 0;
-			maximumScore = score;
-			swapPapers(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
-		}
-	}
-}
-
-void SessionOrganizer::initializeGreedyOrganization()
-{
-	
-	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
-
-	map<int,bool> assigned;
-	for(int i=0;i<totalNumberOfPapers;i++)
-		assigned[i] = false;
-
-	for(int i = 0; i < conference->getSessionsInTrack(); i++)
-	{
-		for(int j = 0; j < conference->getParallelTracks(); j++)
-		{
-			// find the most distant paper
-			double maximum_distance = -1;
-			int most_distant_paper_index;
-			for (int paperIndex1 = 0; paperIndex1 < totalNumberOfPapers; paperIndex1++){
-				
-				if (!assigned[paperIndex1]){
-					
-					double temp_distance = 0;
-					for (int paperIndex2 = 0; paperIndex2 < totalNumberOfPapers; paperIndex2++){
-						
-						if (!assigned[paperIndex2])
-							temp_distance += distanceMatrix[paperIndex1][paperIndex2];
-					}
-
-					if (temp_distance > maximum_distance){
-						
-						maximum_distance = temp_distance;
-						most_distant_paper_index = paperIndex1;
-					}
-				}
-			}
-
-			// set the first paper of the session to be most distant paper
-			conference->setPaper(j, i, 0, most_distant_paper_index);
-			assigned[most_distant_paper_index] = true;
-
-			for(int k = 1; k < conference->getPapersInSession(); k++)
-			{
-				// find the nearest paper for the session
-				double minimum_distance = INT_MAX;
-				int nearest_paper_index;
-	
-				for (int paperIndex2 = 0; paperIndex2 < totalNumberOfPapers; paperIndex2++){
-				
-					if (!assigned[paperIndex2]){
-
-						double temp_distance = 0;
-
-						for (int inSessionPaperIndex = 0; inSessionPaperIndex < k; inSessionPaperIndex++){
-							temp_distance += distanceMatrix[inSessionPaperIndex][paperIndex2];
-						}
-
-						if (temp_distance < minimum_distance){
-							minimum_distance = temp_distance;
-							nearest_paper_index = paperIndex2;
-						}
-					}
-				}
-
-				conference->setPaper(j, i, k, nearest_paper_index);
-				assigned[nearest_paper_index] = true;
-			}
-		}
-	}
-
-	// update the score
-	double score = scoreConference(*conference);
-}
-
-
-bool SessionOrganizer::climbStep() {
-	//cout << "---------------- Climbing Step ---------------------" << endl;
-
-	int int_max = 1000000;
-	long double randomNumber = (long double)(rand() % int_max) / (int_max -1);
-	
-	//with this probability choose the greedy step else swap two randomly chosen papers
-	if(randomNumber <= 1.00)
-	{
-		return greedyStep();
-	}
-}
-
-/**
- * Organize Papers by using Random Restart Hill Climbing Algorithm
- */
-void SessionOrganizer::organizePapers()
-{
-	initializeOrganization(this->conference);
-	
-	globalMaximumScore = conference->getScore();
-	writeConference(*conference);
-
-	// check if there is only one track and one session
-	if (parallelTracks == 1 && sessionsInTrack == 1)
-		return;
-
-	while(true){
-		localBeamSearch(100);
-	}
-}
-
-void SessionOrganizer::writeConference(Conference &conference) {
-	ofstream fout(outputFileName);
-
-	for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
-    {
-        for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
-        {	
-        	Session *currentSession = conference.getSession(trackIndex, sessionIndex);
-            for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
-            {
-                fout<< currentSession->getPaper(paperIndex) << " ";
-            }
-            if(trackIndex != parallelTracks - 1)
-            {
-                fout<< "| ";
-            }
-        }
-        fout<< "\n";
-    }
-}
-
-
-void SessionOrganizer::localBeamSearch(int beamSize) {
-	vector<Conference> beam;
-	vector<Conference> beamNeighbours;
-	int maximumNumberOfIterations = 0;
-
-	initializeOrganization(this->conference);
-	double maximumScore = this->conference->getScore();
-	
-	Conference optimalConference = *(this->conference);
-
-	for(int i=0; i<beamSize; i++){
-		Conference newConference = *conference;
-		initializeOrganization(&newConference);
-		beam.push_back(newConference);
-	}
-
-	double time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);				// time left in seconds
-	double max_iteration_time = 0;																	// in seconds
-
-	do {
-		time_t iteration_start = time(0);
-
-		cout << endl;
-		cout << "Time Left : " << time_left << endl;
-		cout << "iteration = " << maximumNumberOfIterations << endl;
-		for(int i=0; i<beamSize; i++){
-			Conference tmpConference = beam[i];
-			beamNeighbours.push_back(tmpConference);
-
-			for(int j=0; j<beamSize; j++){
-				Conference neighbourConference = beam[i];
-				swapTwoRandomPapers(&neighbourConference);
-				beamNeighbours.push_back(neighbourConference);
-			}
-		}
-
-
-		sort(beamNeighbours.begin(),beamNeighbours.end());
-
-		int neighboursSize = beamNeighbours.size();
-
-		if(beamNeighbours[neighboursSize-1].getScore() > maximumScore){
-			maximumScore = beamNeighbours[neighboursSize-1].getScore();
-			optimalConference = beamNeighbours[neighboursSize-1];
-			cout << "Increased to " << optimalConference.getScore() << endl;
-
-			time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
-			
-			// don't overwrite the outputfile if time is up
-			if(time_left <= 1.0){
-				exit(0);
-			}
-
-			if(optimalConference.getScore() > globalMaximumScore){
-				globalMaximumScore = optimalConference.getScore();
-				writeConference(optimalConference);
-			}
-
-			maximumNumberOfIterations = 0;
-		}else{
-			cout << "nhi badh rha h" << endl;
-			maximumNumberOfIterations++;
-		}
-
-		beam.clear();
-
-		for(int i=0; i<beamSize; i++){
-			beam.push_back(beamNeighbours[neighboursSize-i-1]);
-		}
-
-		beamNeighbours.clear();
-
-		max_iteration_time = max(max_iteration_time, difftime(time(0), iteration_start));
-		time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
-		
-		if (time_left < max_iteration_time) {
-			exit(0);
-		}
-
-	} while (maximumNumberOfIterations < 100);
-}
+/* 
+ * File:   SessionOrganizer.cpp
+ * Author: Harishchandra Patidar
+ * 
+ */
+
+#include <algorithm> // for std::random_shuffle
+#include <map>
+#include <set>
+#include <vector>
+#include <sstream>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include "SessionOrganizer.h"
+#include "ExactSolver.h"
+#include "AssignmentSolver.h"
+#include "Util.h"
+#include "CompensatedSum.h"
+
+
+// the base 2 logarithm of the number of states kept by the visited state cache
+#define VISITED_STATES_LOG2 20
+
+// the number of similar and of dissimilar papers kept for every paper
+#define CANDIDATE_LIST_SIZE 8
+
+// the percentage of local search swaps drawn from the candidate lists
+#define CANDIDATE_SWAP_PERCENT 80
+
+// the largest number of papers moved by an ejection chain
+#define MAX_CHAIN_LENGTH 5
+
+// the seconds between two audits of the incrementally kept scores
+#define SCORE_AUDIT_SECONDS 5
+
+// conferences with at least this many papers are rescored by all threads
+#define PARALLEL_RESCORE_PAPERS 4096
+
+// the seconds between two exchanges of schedules with the other islands
+#define ISLAND_MIGRATION_SECONDS 2
+
+// the shares of the local search time given to each kind of move
+#define SWAP_TIME_SHARE 0.6
+#define ROTATION_TIME_SHARE 0.25
+#define EJECTION_CHAIN_TIME_SHARE 0.15
+
+// the score of a move that breaks a constraint, the cost of placing a paper
+// where it breaks one, and the swaps tried for a paper that breaks one in
+// each of the passes over the papers
+#define INFEASIBLE_SCORE (-numeric_limits<double>::max())
+#define INFEASIBLE_COST 1e12
+#define CONSTRAINT_REPAIR_ATTEMPTS 1000
+#define CONSTRAINT_REPAIR_PASSES 10
+
+// search settings used unless a tuning table gives others
+#define DEFAULT_BEAM_SIZE 100
+#define DEFAULT_STALE_ITERATIONS 100
+#define DEFAULT_GREEDY_SAMPLES 1
+
+// plays the climbing operator bandit looks back on, and its exploration weight
+#define BANDIT_WINDOW 50
+#define BANDIT_EXPLORATION 0.5
+
+// the number of local optima kept for restarting the beam search
+#define ELITE_POOL_SIZE 10
+
+// the swaps compared at every step of path relinking
+#define RELINK_CANDIDATES 16
+
+// the seconds between two allocations of the portfolio threads, the decay of
+// the credit of an engine per epoch, and the random swaps of a climbing kick
+#define PORTFOLIO_EPOCH_SECONDS 1
+#define PORTFOLIO_CREDIT_DECAY 0.5
+#define PORTFOLIO_KICK_SWAPS 3
+// the turns of the engines shared out every epoch, taken in order by the threads
+#define PORTFOLIO_TURNS 16
+
+// the random swaps between two kicked copies of a warm start in the memetic population
+#define MEMETIC_WARM_START_SWAPS 3
+
+// the seconds between two checkpoints of the search
+#define CHECKPOINT_SECONDS 30
+
+// the most papers the exact search takes, as its bound tables grow with the cube of the papers
+#define EXACT_MAXIMUM_PAPERS 48
+
+SessionOrganizer::SessionOrganizer() : conference(NULL), visitedStates(VISITED_STATES_LOG2), climbBandit(NUMBER_OF_CLIMB_OPERATORS, BANDIT_WINDOW, BANDIT_EXPLORATION)
+{
+	distanceMatrix = NULL;
+	distanceBlock = NULL;
+	lastMigrationTime = 0;
+	lastScoreAuditTime = 0;
+	worstScoreDrift = 0.0;
+	memoryPolicy = MatrixAllocator::DEFAULT_PAGES;
+	parallelTracks = 0;
+	papersInSession = 0;
+	sessionsInTrack = 0;
+	processingTimeInMinutes = 0;
+	tradeoffCoefficient = 1.0;
+	outputFileName = "output.txt";
+	globalMaximumScore = 0.0;
+	updatesFileTime = 0;
+	searchMode = "beam";
+	randomGenerator.seed(rand());
+	islandGenerator.seed(rand());
+	quantizeDistances = true;
+	similarityWeight = parallelWeight = distanceOne = scoreUnit = 1.0;
+	numberOfRestarts = 0;
+	takenIncumbentVersion = 0;
+	lastCheckpointTime = 0;
+	resumeSearch = false;
+	resumedIterations = 0;
+	upperBound = gapThreshold = 0.0;
+	beamSize = DEFAULT_BEAM_SIZE;
+	staleIterations = DEFAULT_STALE_ITERATIONS;
+	greedySamples = DEFAULT_GREEDY_SAMPLES;
+}
+
+SessionOrganizer::SessionOrganizer(double **distanceMatrix, int parallelTracks, int sessionsInTrack, int papersInSession, double tradeoffCoefficient) : SessionOrganizer()
+{
+	this->distanceMatrix = distanceMatrix;
+	this->parallelTracks = parallelTracks;
+	this->sessionsInTrack = sessionsInTrack;
+	this->papersInSession = papersInSession;
+	this->tradeoffCoefficient = tradeoffCoefficient;
+	conference = new Conference(parallelTracks, sessionsInTrack, papersInSession);
+	initializeDistanceStorage();
+}
+
+SessionOrganizer::SessionOrganizer(string inputFileName, string outputFileName, time_t starting_time, string islandName) : visitedStates(VISITED_STATES_LOG2), climbBandit(NUMBER_OF_CLIMB_OPERATORS, BANDIT_WINDOW, BANDIT_EXPLORATION)
+{
+	this->outputFileName = outputFileName;
+	this->islandName = islandName;
+	this->lastMigrationTime = starting_time;
+	this->lastScoreAuditTime = starting_time;
+	this->worstScoreDrift = 0.0;
+	this->starting_time = starting_time;
+	this->updatesFileTime = 0;
+	this->searchMode = "beam";
+	this->randomGenerator.seed(rand());
+	this->islandGenerator.seed(rand());
+	this->quantizeDistances = true;
+	this->memoryPolicy = MatrixAllocator::DEFAULT_PAGES;
+	this->numberOfRestarts = 0;
+	this->takenIncumbentVersion = 0;
+	this->lastCheckpointTime = starting_time;
+	this->resumeSearch = false;
+	this->resumedIterations = 0;
+	this->upperBound = this->gapThreshold = 0.0;
+	this->beamSize = DEFAULT_BEAM_SIZE;
+	this->staleIterations = DEFAULT_STALE_ITERATIONS;
+	this->greedySamples = DEFAULT_GREEDY_SAMPLES;
+	readInInputFile(inputFileName);
+	if(island.isCreator())
+		island.setReady();
+	conference = new Conference(parallelTracks, sessionsInTrack, papersInSession);
+	initializeDistanceStorage();
+}
+
+void SessionOrganizer::readInInputFile(string filename)
+{
+	// the file is mapped, and the rows are parsed where they lie
+	int descriptor = open(filename.c_str(), O_RDONLY);
+	struct stat status;
+	if(descriptor < 0 || fstat(descriptor, &status) != 0)
+	{
+		cout << "Unable to open input file" << endl;
+		exit(0);
+	}
+	size_t size = status.st_size;
+	const char *data = "";
+	if(size > 0)
+	{
+		void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		data = mapping == MAP_FAILED ? NULL : (const char*)mapping;
+		if(data != NULL)
+			madvise(mapping, size, MADV_SEQUENTIAL);
+	}
+	close(descriptor);
+	if(data == NULL)
+	{
+		cout << "Unable to open input file" << endl;
+		exit(0);
+	}
+
+	// the start of every line, and the end of the last one
+	vector<const char*> lines;
+	const char *position = data;
+	const char *end = data + size;
+	while(position < end)
+	{
+		lines.push_back(position);
+		const char *newline = (const char*)memchr(position, '\n', end - position);
+		position = newline == NULL ? end : newline + 1;
+	}
+	lines.push_back(end);
+
+	vector<string> header;
+	for(int i = 0; i < 5 && i + 1 < lines.size(); i++)
+		header.push_back(string(lines[i], lines[i + 1]));
+
+	// an island joining a running island model takes the matrix from the shared segment
+	if(header.size() == 5 && !islandName.empty() && joinIsland(filename, header))
+	{
+		if(size > 0)
+			munmap((void*)data, size);
+		readInRows(NULL);
+		return;
+	}
+
+	if (6 > lines.size() - 1)
+	{
+		cout << "Not enough information given, check format of input file";
+		exit(0);
+	}
+
+	readInHeader(header);
+
+	int numberOfPapers = lines.size() - 6;
+	int slots = parallelTracks * papersInSession*sessionsInTrack;
+	if(slots != numberOfPapers)
+	{
+		cout << "More papers than slots available! slots:" << slots << " num papers:" << numberOfPapers << endl;
+		exit(0);
+	}
+
+	int n = numberOfPapers;
+	double ** tempDistanceMatrix = new double*[n];
+
+	// the island creating the segment reads the matrix into it
+	bool shared = island.isCreator();
+	double *block = shared ? island.getDistances() : (double*)MatrixAllocator::allocate(sizeof(double) * n * n, memoryPolicy);
+	if(block == NULL && !shared && memoryPolicy != MatrixAllocator::DEFAULT_PAGES)
+	{
+		// the pages of the policy may not be available, plain pages are tried next
+		cout << "Unable to allocate the distance matrix with memory policy " << MatrixAllocator::getPolicyName(memoryPolicy) << ", using default pages" << endl;
+		memoryPolicy = MatrixAllocator::DEFAULT_PAGES;
+		block = (double*)MatrixAllocator::allocate(sizeof(double) * n * n, memoryPolicy);
+	}
+	if(block == NULL)
+	{
+		cout << "Unable to allocate the distance matrix of " << n << " papers" << endl;
+		exit(0);
+	}
+	distanceBlock = shared ? NULL : block;
+	for(int i = 0; i < n; ++i)
+	{
+		tempDistanceMatrix[i] = block + (size_t)i * n;
+	}
+	distanceMatrix = tempDistanceMatrix;
+
+	readInRows(&lines);
+	if(size > 0)
+		munmap((void*)data, size);
+}
+
+/**
+ * Read the next whitespace separated number of [position, end), 0 if there is none.
+ */
+static double readInDistance(const char *&position, const char *end)
+{
+	while(position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+		position++;
+
+	// the mapping is not null terminated, so the token is copied out
+	char token[64];
+	int length = 0;
+	while(position < end && !(*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+	{
+		if(length < 63)
+			token[length++] = *position;
+		position++;
+	}
+	token[length] = '\0';
+	return atof(token);
+}
+
+void SessionOrganizer::readInRows(const vector<const char*> *lines)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+	statistics.init(totalNumberOfPapers, numberOfThreads);
+	candidateLists.init(totalNumberOfPapers, CANDIDATE_LIST_SIZE);
+
+	atomic<int> nextRow(0);
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		threads.push_back(thread([&, t]() {
+			vector<int> others;
+			for(int row = nextRow++; row < totalNumberOfPapers; row = nextRow++){
+				double *distances = distanceMatrix[row];
+				if(lines != NULL){
+					const char *position = (*lines)[5 + row];
+					const char *end = (*lines)[6 + row];
+					for(int column = 0; column < totalNumberOfPapers; column++)
+						distances[column] = readInDistance(position, end);
+				}
+
+				statistics.addRow(distances, row, t);
+				candidateLists.buildRow(distances, row, others);
+			}
+		}));
+	}
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+	}
+	statistics.finish();
+}
+
+void SessionOrganizer::readInHeader(vector<string> &lines)
+{
+	processingTimeInMinutes = atof(lines[0].c_str());
+	papersInSession = atoi(lines[1].c_str());
+	parallelTracks = atoi(lines[2].c_str());
+	sessionsInTrack = atoi(lines[3].c_str());
+	tradeoffCoefficient = atof(lines[4].c_str());
+}
+
+bool SessionOrganizer::joinIsland(string filename, vector<string> &lines)
+{
+	readInHeader(lines);
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	if(!island.attach(islandName, filename, totalNumberOfPapers, tradeoffCoefficient))
+	{
+		cout << "Unable to join island model " << islandName << ", running alone" << endl;
+		islandName.clear();
+		return false;
+	}
+
+	if(island.isCreator())
+	{
+		cout << "Created island model " << islandName << endl;
+		return false;
+	}
+
+	cout << "Joined island model " << islandName << " with " << island.getNumberOfIslands() << " islands" << endl;
+	distanceMatrix = new double*[totalNumberOfPapers];
+	distanceBlock = NULL;
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		distanceMatrix[i] = island.getDistances() + (size_t)i * totalNumberOfPapers;
+	}
+	return true;
+}
+
+void SessionOrganizer::getSchedule(Conference &conference, vector<int> &papers)
+{
+	papers.resize(parallelTracks * sessionsInTrack * papersInSession);
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				papers[(trackIndex * sessionsInTrack + sessionIndex) * papersInSession + paperIndex] = conference.getPaper(trackIndex, sessionIndex, paperIndex);
+			}
+		}
+	}
+}
+
+bool SessionOrganizer::setSchedule(vector<int> &papers, Conference &conference)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	vector<bool> placed(totalNumberOfPapers, false);
+	for(int i = 0; i < papers.size(); i++)
+	{
+		if(papers[i] < 0 || papers[i] >= totalNumberOfPapers || placed[papers[i]])
+			return false;
+		placed[papers[i]] = true;
+	}
+
+	conference = Conference(parallelTracks, sessionsInTrack, papersInSession);
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				conference.setPaper(trackIndex, sessionIndex, paperIndex, papers[(trackIndex * sessionsInTrack + sessionIndex) * papersInSession + paperIndex]);
+			}
+		}
+	}
+	scoreConference(conference);
+	return true;
+}
+
+bool SessionOrganizer::scoreSchedule(vector<int> &papers, double &score)
+{
+	Conference scheduleConference;
+	if(papers.size() != parallelTracks * sessionsInTrack * papersInSession || !setSchedule(papers, scheduleConference))
+		return false;
+
+	score = getReportedScore(scheduleConference.getScore());
+	return true;
+}
+
+bool SessionOrganizer::exchangeWithIslands(Conference &optimalConference, Conference &immigrant)
+{
+	if(!island.isAttached() || difftime(time(0), lastMigrationTime) < ISLAND_MIGRATION_SECONDS)
+		return false;
+	lastMigrationTime = time(0);
+
+	vector<int> papers;
+	getSchedule(optimalConference, papers);
+	island.publishElite(papers, getReportedScore(optimalConference.getScore()));
+
+	// the best schedule of all islands if it beats ours, else an elite of another island
+	double score;
+	if(!(island.readIncumbent(papers, score) && score > getReportedScore(optimalConference.getScore())) && !island.readElite(islandGenerator, papers, score))
+		return false;
+
+	return setSchedule(papers, immigrant);
+}
+
+double** SessionOrganizer::getDistanceMatrix()
+{
+	return distanceMatrix;
+}
+
+void SessionOrganizer::setWarmStartFile(string fileName)
+{
+	warmStartFileName = fileName;
+}
+
+void SessionOrganizer::setResume(bool resume)
+{
+	resumeSearch = resume;
+}
+
+void SessionOrganizer::setSearchMode(string mode)
+{
+	searchMode = mode;
+}
+
+void SessionOrganizer::setMemoryPolicy(string policy)
+{
+	MatrixAllocator::Policy newPolicy;
+	if(!MatrixAllocator::parsePolicy(policy, newPolicy))
+	{
+		cout << "Unknown memory policy " << policy << endl;
+		exit(0);
+	}
+
+	// the double matrix is read by every thread alike, it is interleaved rather than replicated
+	MatrixAllocator::Policy blockPolicy = newPolicy == MatrixAllocator::REPLICATED_NODES ? MatrixAllocator::INTERLEAVED_NODES : newPolicy;
+	MatrixAllocator::Policy oldBlockPolicy = memoryPolicy == MatrixAllocator::REPLICATED_NODES ? MatrixAllocator::INTERLEAVED_NODES : memoryPolicy;
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	size_t size = sizeof(double) * totalNumberOfPapers * totalNumberOfPapers;
+	double *block = (double*)MatrixAllocator::allocate(size, blockPolicy);
+	if(block == NULL)
+	{
+		cout << "Unable to allocate the distance matrix with memory policy " << policy << endl;
+		exit(0);
+	}
+
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		memcpy(block + (size_t)i * totalNumberOfPapers, distanceMatrix[i], sizeof(double) * totalNumberOfPapers);
+		distanceMatrix[i] = block + (size_t)i * totalNumberOfPapers;
+	}
+	MatrixAllocator::release(distanceBlock, size, oldBlockPolicy);
+	distanceBlock = block;
+
+	memoryPolicy = newPolicy;
+	initializeDistanceStorage();
+}
+
+void SessionOrganizer::setGapThreshold(double gap)
+{
+	gapThreshold = gap;
+}
+
+void SessionOrganizer::setTuningFile(string fileName)
+{
+	ifstream file(fileName.c_str());
+	if(!file.is_open())
+	{
+		cout << "Unable to read tuning table " << fileName << endl;
+		exit(0);
+	}
+
+	// the closest row by the ratios of the shape, papers in session count as much as tracks and time slots
+	double shape[3] = { log((double)papersInSession), log((double)parallelTracks), log((double)sessionsInTrack) };
+	double closestDistance = -1.0;
+	int closestRow[6] = { 0, 0, 0, 0, 0, 0 };
+
+	string line;
+	while(getline(file, line))
+	{
+		if(line.empty() || line[0] == '#')
+			continue;
+
+		istringstream row(line);
+		int values[6];
+		bool complete = true;
+		for(int i = 0; i < 6; i++)
+		{
+			if(!(row >> values[i]) || values[i] < 1)
+				complete = false;
+		}
+		if(!complete)
+		{
+			cout << "Ignoring tuning table line: " << line << endl;
+			continue;
+		}
+
+		double distance = 0.0;
+		for(int i = 0; i < 3; i++)
+			distance += (log((double)values[i]) - shape[i]) * (log((double)values[i]) - shape[i]);
+		if(closestDistance < 0.0 || distance < closestDistance)
+		{
+			closestDistance = distance;
+			copy(values, values + 6, closestRow);
+		}
+	}
+
+	if(closestDistance < 0.0)
+	{
+		cout << "No settings in tuning table " << fileName << endl;
+		exit(0);
+	}
+
+	beamSize = closestRow[3];
+	staleIterations = closestRow[4];
+	greedySamples = closestRow[5];
+	cout << "Settings tuned for " << closestRow[0] << " " << closestRow[1] << " " << closestRow[2]
+		<< " : beam size " << beamSize << ", stale iterations " << staleIterations << ", greedy samples " << greedySamples << endl;
+}
+
+void SessionOrganizer::setConstraintsFile(string fileName)
+{
+	ifstream file(fileName.c_str());
+	if(!file.is_open())
+	{
+		cout << "Unable to read constraints file " << fileName << endl;
+		exit(0);
+	}
+
+	constraints.init(parallelTracks * sessionsInTrack * papersInSession, sessionsInTrack);
+
+	string line;
+	int lineNumber = 0;
+	while(getline(file, line))
+	{
+		lineNumber++;
+		istringstream row(line);
+		string kind;
+		if(!(row >> kind) || kind[0] == '#')
+			continue;
+
+		int first, second;
+		bool added = false;
+		if(row >> first >> second)
+		{
+			if(kind == "conflict")
+				added = constraints.addConflict(first, second);
+			else if(kind == "pin")
+				added = constraints.addPin(first, second);
+			else if(kind == "apart")
+				added = constraints.addApart(first, second);
+		}
+
+		if(!added)
+		{
+			cout << "Bad constraint on line " << lineNumber << " of " << fileName << ": " << line << endl;
+			exit(0);
+		}
+	}
+
+	cout << "Read " << constraints.getNumberOfConstraints() << " constraints on " << constraints.getConstrainedPapers().size() << " papers" << endl;
+
+	// the copies of the conference made by the searches count the partners too
+	conference->setConstraints(&constraints);
+}
+
+void SessionOrganizer::setProcessingTime(double minutes)
+{
+	processingTimeInMinutes = minutes;
+}
+
+void SessionOrganizer::setDistanceStorage(string storage)
+{
+	quantizeDistances = storage != "double";
+	initializeDistanceStorage();
+}
+
+void SessionOrganizer::initializeDistanceStorage()
+{
+	similarityWeight = distanceOne = scoreUnit = 1.0;
+	parallelWeight = tradeoffCoefficient;
+
+	// the session sums are specialized for the number of papers in a session
+	sessionKernels.select(papersInSession);
+	quantizedMatrix.selectKernels(papersInSession);
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	// the statistics found the units while the rows were read
+	bool quantized = false;
+	if(quantizeDistances && statistics.isValid())
+		quantized = quantizedMatrix.build(distanceMatrix, totalNumberOfPapers, memoryPolicy, statistics.getQuantizationScale());
+	else if(quantizeDistances)
+		quantized = quantizedMatrix.build(distanceMatrix, totalNumberOfPapers, memoryPolicy);
+	if(!quantized)
+	{
+		quantizedMatrix.clear();
+		return;
+	}
+
+	// the tradeoff coefficient as a fraction with the smallest power of ten below
+	int scale = quantizedMatrix.getScale();
+	for(long long denominator = 1; denominator <= 10000; denominator *= 10)
+	{
+		double numerator = tradeoffCoefficient * denominator;
+		double rounded = floor(numerator + 0.5);
+		if(fabs(numerator - rounded) > 1e-9 * max(1.0, fabs(numerator)))
+			continue;
+
+		// every score must stay a whole number a double holds exactly
+		double largestScore = 0.5 * totalNumberOfPapers * totalNumberOfPapers * 65535.0 * max((double)denominator, fabs(rounded));
+		if(largestScore > 1e15)
+			break;
+
+		similarityWeight = (double)denominator;
+		parallelWeight = rounded;
+		distanceOne = scale;
+		scoreUnit = 1.0 / ((double)scale * denominator);
+		return;
+	}
+
+	quantizedMatrix.clear();
+}
+
+void SessionOrganizer::releaseDistanceMatrix()
+{
+	if(quantizedMatrix.getScale() == 0 || distanceBlock == NULL)
+		return;
+
+	// the double matrix is read by every thread alike, it is interleaved rather than replicated
+	MatrixAllocator::Policy blockPolicy = memoryPolicy == MatrixAllocator::REPLICATED_NODES ? MatrixAllocator::INTERLEAVED_NODES : memoryPolicy;
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	MatrixAllocator::release(distanceBlock, sizeof(double) * totalNumberOfPapers * totalNumberOfPapers, blockPolicy);
+	delete[] distanceMatrix;
+	distanceMatrix = NULL;
+	distanceBlock = NULL;
+}
+
+void SessionOrganizer::restoreDistanceMatrix()
+{
+	if(distanceMatrix != NULL)
+		return;
+
+	MatrixAllocator::Policy blockPolicy = memoryPolicy == MatrixAllocator::REPLICATED_NODES ? MatrixAllocator::INTERLEAVED_NODES : memoryPolicy;
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	double *block = (double*)MatrixAllocator::allocate(sizeof(double) * totalNumberOfPapers * totalNumberOfPapers, blockPolicy);
+	if(block == NULL)
+	{
+		cout << "Unable to allocate the distance matrix of " << totalNumberOfPapers << " papers" << endl;
+		exit(0);
+	}
+
+	// the distances were whole numbers of units, so dividing gives them back as read
+	distanceMatrix = new double*[totalNumberOfPapers];
+	distanceBlock = block;
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		distanceMatrix[i] = block + (size_t)i * totalNumberOfPapers;
+		for(int j = 0; j < totalNumberOfPapers; j++)
+			distanceMatrix[i][j] = (double)quantizedMatrix.getDistance(i, j) / quantizedMatrix.getScale();
+	}
+}
+
+double SessionOrganizer::getReportedScore(double score)
+{
+	return score * scoreUnit;
+}
+
+void SessionOrganizer::setUpdatesFile(string fileName)
+{
+	updatesFileName = fileName;
+}
+
+double SessionOrganizer::getScoreDeltaForDistanceUpdate(Conference &conference, int paper1, int paper2, double oldDistance, double newDistance)
+{
+	int trackIndex1, sessionIndex1, paperIndex1;
+	int trackIndex2, sessionIndex2, paperIndex2;
+
+	if(paper1 == paper2 || !conference.getPaperLocation(paper1, trackIndex1, sessionIndex1, paperIndex1) || !conference.getPaperLocation(paper2, trackIndex2, sessionIndex2, paperIndex2))
+		return 0.0;
+
+	// papers in different time slots do not interact
+	if(sessionIndex1 != sessionIndex2)
+		return 0.0;
+
+	// the entry is only read for the pair in this order
+	if(trackIndex1 == trackIndex2)
+		return paperIndex1 < paperIndex2 ? -similarityWeight * (newDistance - oldDistance) : 0.0;
+
+	return trackIndex1 < trackIndex2 ? parallelWeight * (newDistance - oldDistance) : 0.0;
+}
+
+void SessionOrganizer::applyDistanceUpdates(const vector<DistanceUpdate> &updates, vector<Conference*> &conferences)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	// the other islands keep the distances of the shared matrix
+	if(distanceBlock == NULL && distanceMatrix != NULL && !updates.empty())
+		setMemoryPolicy(MatrixAllocator::getPolicyName(memoryPolicy));
+
+	// the rows whose candidate lists are built again once every update is in
+	set<int> changedRows;
+
+	// an update the fixed point distances can not hold exactly moves them to
+	// 16 bits, or back to the distance matrix, and every score is recomputed
+	bool requantize = false;
+	for(int i = 0; i < updates.size() && quantizedMatrix.getScale() > 0; i++)
+	{
+		if(!quantizedMatrix.canHold(updates[i].distance))
+			requantize = true;
+	}
+	if(requantize)
+		restoreDistanceMatrix();
+
+	for(int i = 0; i < updates.size(); i++)
+	{
+		int paper1 = updates[i].paper1;
+		int paper2 = updates[i].paper2;
+		if(paper1 < 0 || paper2 < 0 || paper1 >= totalNumberOfPapers || paper2 >= totalNumberOfPapers)
+		{
+			cout << "Ignoring update of distance between " << paper1 << " and " << paper2 << endl;
+			continue;
+		}
+
+		// an update sets the distance both ways, as the scores read either entry of a pair
+		int rows[2] = {paper1, paper2};
+		for(int k = 0; k < (paper1 == paper2 ? 1 : 2); k++)
+		{
+			int row = rows[k];
+			int column = rows[1 - k];
+			changedRows.insert(row);
+
+			if(requantize)
+			{
+				distanceMatrix[row][column] = updates[i].distance;
+				continue;
+			}
+
+			double oldDistance = getScoringDistance(row, column);
+			double newDistance = updates[i].distance;
+			if(quantizedMatrix.getScale() > 0)
+			{
+				// the update is rounded to a whole number of units
+				newDistance = quantizedMatrix.setDistance(row, column, newDistance);
+			}
+
+			for(int j = 0; j < conferences.size(); j++)
+			{
+				conferences[j]->increaseScore(getScoreDeltaForDistanceUpdate(*conferences[j], row, column, oldDistance, newDistance));
+			}
+			bestConference.increaseScore(getScoreDeltaForDistanceUpdate(bestConference, row, column, oldDistance, newDistance));
+
+			if(distanceMatrix != NULL)
+				distanceMatrix[row][column] = newDistance / distanceOne;
+		}
+	}
+
+	if(requantize)
+	{
+		statistics.clear();
+		initializeDistanceStorage();
+		cout << "Rescoring with " << (quantizedMatrix.getScale() > 0 ? quantizedMatrix.getBits() : 64) << " bit distances" << endl;
+
+		for(int j = 0; j < conferences.size(); j++)
+		{
+			scoreConference(*conferences[j], 1);
+		}
+		if(bestConference.getParallelTracks() > 0)
+			scoreConference(bestConference, 1);
+		releaseDistanceMatrix();
+	}
+
+	// the candidate lists only compare distances, the units do not matter
+	vector<int> others;
+	vector<double> distances(totalNumberOfPapers);
+	for(set<int>::iterator row = changedRows.begin(); row != changedRows.end(); ++row)
+	{
+		for(int column = 0; column < totalNumberOfPapers; column++)
+			distances[column] = getScoringDistance(*row, column);
+		candidateLists.buildRow(&distances[0], *row, others);
+	}
+
+	// the output file holds the best conference, compare against its new score
+	if(bestConference.getParallelTracks() > 0)
+		globalMaximumScore = bestConference.getScore();
+
+	if(!updates.empty())
+		statistics.clear();
+	if(!updates.empty() && upperBound != 0.0)
+		upperBound = computeUpperBound(max(1u, thread::hardware_concurrency()));
+}
+
+void SessionOrganizer::applyDistanceUpdates(const vector<DistanceUpdate> &updates)
+{
+	vector<Conference*> conferences(1, conference);
+	applyDistanceUpdates(updates, conferences);
+}
+
+void SessionOrganizer::queueDistanceUpdates(const vector<DistanceUpdate> &updates)
+{
+	lock_guard<mutex> lock(pendingUpdatesMutex);
+	pendingUpdates.insert(pendingUpdates.end(), updates.begin(), updates.end());
+}
+
+void SessionOrganizer::readInUpdatesFile()
+{
+	struct stat fileStatus;
+	if(updatesFileName.empty() || stat(updatesFileName.c_str(), &fileStatus) != 0 || fileStatus.st_mtime == updatesFileTime)
+		return;
+	updatesFileTime = fileStatus.st_mtime;
+
+	ifstream myfile(updatesFileName.c_str());
+	vector<DistanceUpdate> updates;
+	DistanceUpdate update;
+	while(myfile >> update.paper1 >> update.paper2 >> update.distance)
+	{
+		updates.push_back(update);
+	}
+
+	queueDistanceUpdates(updates);
+}
+
+bool SessionOrganizer::applyPendingDistanceUpdates(vector<Conference> &beam, Conference &optimalConference)
+{
+	readInUpdatesFile();
+
+	vector<DistanceUpdate> updates;
+	{
+		lock_guard<mutex> lock(pendingUpdatesMutex);
+		updates.swap(pendingUpdates);
+	}
+	if(updates.empty())
+		return false;
+
+	vector<Conference*> conferences;
+	for(int i = 0; i < beam.size(); i++)
+	{
+		conferences.push_back(&beam[i]);
+	}
+	conferences.push_back(&optimalConference);
+	conferences.push_back(this->conference);
+
+	applyDistanceUpdates(updates, conferences);
+	cout << "Applied " << updates.size() << " distance updates" << endl;
+
+	return true;
+}
+
+bool SessionOrganizer::readInScheduleFile(string filename, Conference &conference)
+{
+	ifstream myfile(filename.c_str());
+	if(!myfile.is_open())
+	{
+		cout << "Unable to open schedule file " << filename << endl;
+		return false;
+	}
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	vector<bool> placed(totalNumberOfPapers, false);
+
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				conference.setPaper(trackIndex, sessionIndex, paperIndex, -1);
+			}
+		}
+	}
+
+	// every line is a time slot, tracks are separated by '|'
+	string line;
+	int sessionIndex = 0;
+	while(sessionIndex < sessionsInTrack && getline(myfile, line))
+	{
+		if(line.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		for(size_t i = 0; i < line.size(); i++)
+		{
+			if(line[i] == '|')
+				line.replace(i, 1, " | "), i += 2;
+		}
+
+		stringstream row(line);
+		string token;
+		int trackIndex = 0;
+		int paperIndex = 0;
+		while(row >> token)
+		{
+			if(token == "|")
+			{
+				trackIndex++;
+				paperIndex = 0;
+				continue;
+			}
+
+			int paperId = atoi(token.c_str());
+			if(trackIndex < parallelTracks && paperIndex < papersInSession && paperId >= 0 && paperId < totalNumberOfPapers && !placed[paperId])
+			{
+				conference.setPaper(trackIndex, sessionIndex, paperIndex, paperId);
+				placed[paperId] = true;
+			}
+			paperIndex++;
+		}
+		sessionIndex++;
+	}
+
+	return true;
+}
+
+double SessionOrganizer::getInsertionGain(Conference &conference, int paperId, int trackIndex, int sessionIndex, int paperIndex)
+{
+	double gain = 0.0;
+
+	Session *session = conference.getSession(trackIndex, sessionIndex);
+	for(int i = 0; i < session->getNumberOfPapers(); i++)
+	{
+		int paper = session->getPaper(i);
+		if(i != paperIndex && paper >= 0)
+		{
+			gain += similarityWeight * (distanceOne - (i < paperIndex ? getScoringDistance(paper, paperId) : getScoringDistance(paperId, paper)));
+		}
+	}
+
+	for(int trackIndex2 = 0; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
+	{
+		if(trackIndex2 == trackIndex)
+			continue;
+
+		Session *parallelSession = conference.getSession(trackIndex2, sessionIndex);
+		for(int i = 0; i < parallelSession->getNumberOfPapers(); i++)
+		{
+			int paper = parallelSession->getPaper(i);
+			if(paper >= 0)
+			{
+				gain += parallelWeight * (trackIndex2 < trackIndex ? getScoringDistance(paper, paperId) : getScoringDistance(paperId, paper));
+			}
+		}
+	}
+
+	return gain;
+}
+
+int SessionOrganizer::repairOrganization(Conference &conference)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	vector<bool> placed(totalNumberOfPapers, false);
+
+	// collect the empty slots
+	vector<int> emptyTracks, emptySessions, emptyPapers;
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				int paper = conference.getPaper(trackIndex, sessionIndex, paperIndex);
+				if(paper >= 0)
+				{
+					placed[paper] = true;
+				}
+				else
+				{
+					emptyTracks.push_back(trackIndex);
+					emptySessions.push_back(sessionIndex);
+					emptyPapers.push_back(paperIndex);
+				}
+			}
+		}
+	}
+
+	// put every missing paper in the empty slot where it gains the most
+	int placedPapers = 0;
+	for(int paperId = 0; paperId < totalNumberOfPapers; paperId++)
+	{
+		if(placed[paperId])
+			continue;
+
+		int bestSlot = 0;
+		double bestGain = 0.0;
+		for(int slot = 0; slot < emptyTracks.size(); slot++)
+		{
+			double gain = getInsertionGain(conference, paperId, emptyTracks[slot], emptySessions[slot], emptyPapers[slot]);
+
+			// slots that break a constraint are taken only if there is no other
+			PaperSlot destination = { emptyTracks[slot], emptySessions[slot], emptyPapers[slot] };
+			if(!isMoveFeasible(conference, &paperId, &destination, 1))
+				gain -= INFEASIBLE_COST;
+
+			if(slot == 0 || gain > bestGain)
+			{
+				bestGain = gain;
+				bestSlot = slot;
+			}
+		}
+
+		conference.setPaper(emptyTracks[bestSlot], emptySessions[bestSlot], emptyPapers[bestSlot], paperId);
+		emptyTracks.erase(emptyTracks.begin() + bestSlot);
+		emptySessions.erase(emptySessions.begin() + bestSlot);
+		emptyPapers.erase(emptyPapers.begin() + bestSlot);
+		placedPapers++;
+	}
+
+	return placedPapers;
+}
+
+bool SessionOrganizer::initializeWarmOrganization(Conference *conference)
+{
+	if(!readInScheduleFile(warmStartFileName, *conference))
+		return false;
+
+	int placedPapers = repairOrganization(*conference);
+
+	// update the score
+	scoreConference(*conference);
+	repairConstraints(*conference, randomGenerator);
+	double score = conference->getScore();
+	cout << "Warm start from " << warmStartFileName << " : " << placedPapers << " papers placed by repair, score " << getReportedScore(score) << endl;
+
+	return true;
+}
+
+double SessionOrganizer::getSimilarityScoreForSession(Conference &conference, int trackIndex, int sessionIndex)
+{
+	Session *session = conference.getSession(trackIndex,sessionIndex);
+	int numberOfPapers = session->getNumberOfPapers();
+	if(quantizedMatrix.getScale() > 0)
+	{
+		return similarityWeight * quantizedMatrix.getSimilarityUnits(session->getPapers(), numberOfPapers);
+	}
+
+	double pairs = numberOfPapers * (numberOfPapers - 1) / 2;
+	return pairs - sessionKernels.sumPairs(DoubleRows(distanceMatrix), session->getPapers(), numberOfPapers);
+}
+
+double SessionOrganizer::getParallelScoreBetweenSessions(Conference &conference, int trackIndex1, int sessionIndex1, int trackIndex2, int sessionIndex2)
+{
+	Session *session1 = conference.getSession(trackIndex1, sessionIndex1);
+	Session *session2 = conference.getSession(trackIndex2, sessionIndex2);
+	if(quantizedMatrix.getScale() > 0)
+	{
+		return quantizedMatrix.getParallelUnits(session1->getPapers(), session1->getNumberOfPapers(), session2->getPapers(), session2->getNumberOfPapers());
+	}
+
+	return sessionKernels.sumCross(DoubleRows(distanceMatrix), session1->getPapers(), session1->getNumberOfPapers(),
+		session2->getPapers(), session2->getNumberOfPapers());
+}
+
+double SessionOrganizer::getParallelScoreForSession(Conference &conference, int trackIndex, int sessionIndex)
+{
+	double score = 0.0;
+
+	for(int trackIndex2 = 0; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
+	{
+		if(trackIndex2 != trackIndex){
+			score += this->getParallelScoreBetweenSessions(conference,trackIndex,sessionIndex,trackIndex2,sessionIndex);
+		}
+	}
+
+	return score;
+}
+
+double SessionOrganizer::getTimeSlotScore(Conference &conference, int sessionIndex)
+{
+	// fixed point scores are whole numbers and add up exactly
+	if(quantizedMatrix.getScale() > 0)
+	{
+		double score = 0.0;
+		for(int trackIndex1 = 0; trackIndex1 < conference.getParallelTracks(); trackIndex1++)
+		{
+			score += getSimilarityScoreForSession(conference, trackIndex1, sessionIndex);
+			for(int trackIndex2 = trackIndex1 + 1; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
+			{
+				score += parallelWeight * getParallelScoreBetweenSessions(conference, trackIndex1, sessionIndex, trackIndex2, sessionIndex);
+			}
+		}
+		return score;
+	}
+
+	CompensatedSum score;
+	for(int trackIndex1 = 0; trackIndex1 < conference.getParallelTracks(); trackIndex1++)
+	{
+		Session *session1 = conference.getSession(trackIndex1, sessionIndex);
+		for(int i = 0; i < session1->getNumberOfPapers(); i++)
+		{
+			int paper1 = session1->getPaper(i);
+			for(int j = i + 1; j < session1->getNumberOfPapers(); j++)
+			{
+				score.add(1.0 - distanceMatrix[paper1][session1->getPaper(j)]);
+			}
+
+			for(int trackIndex2 = trackIndex1 + 1; trackIndex2 < conference.getParallelTracks(); trackIndex2++)
+			{
+				Session *session2 = conference.getSession(trackIndex2, sessionIndex);
+				for(int j = 0; j < session2->getNumberOfPapers(); j++)
+				{
+					score.add(parallelWeight * distanceMatrix[paper1][session2->getPaper(j)]);
+				}
+			}
+		}
+	}
+	return score.getSum();
+}
+
+double SessionOrganizer::scoreConference(Conference &conference, int numberOfThreads)
+{
+	int numberOfSlots = conference.getSessionsInTrack();
+	vector<double> slotScores(numberOfSlots);
+
+	// the time slots are scored independently, split between threads
+	numberOfThreads = max(1, min(numberOfThreads, numberOfSlots));
+	if(numberOfThreads == 1)
+	{
+		for(int sessionIndex = 0; sessionIndex < numberOfSlots; sessionIndex++)
+			slotScores[sessionIndex] = getTimeSlotScore(conference, sessionIndex);
+	}
+	else
+	{
+		vector<thread> threads;
+		for(int t = 0; t < numberOfThreads; t++)
+		{
+			threads.push_back(thread([&, t]() {
+				for(int sessionIndex = t; sessionIndex < numberOfSlots; sessionIndex += numberOfThreads)
+					slotScores[sessionIndex] = getTimeSlotScore(conference, sessionIndex);
+			}));
+		}
+		for(int t = 0; t < numberOfThreads; t++)
+		{
+			threads[t].join();
+		}
+	}
+
+	// added in a fixed order, so the score does not depend on the number of threads
+	CompensatedSum score;
+	for(int sessionIndex = 0; sessionIndex < numberOfSlots; sessionIndex++)
+		score.add(slotScores[sessionIndex]);
+
+	conference.increaseScore(score.getSum() - conference.getScore());
+	return score.getSum();
+}
+
+bool SessionOrganizer::isScoreAuditDue()
+{
+	if(difftime(time(0), lastScoreAuditTime) < SCORE_AUDIT_SECONDS)
+		return false;
+
+	lastScoreAuditTime = time(0);
+	return true;
+}
+
+double SessionOrganizer::auditScore(Conference &conference)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int numberOfThreads = totalNumberOfPapers >= PARALLEL_RESCORE_PAPERS ? max(1u, thread::hardware_concurrency()) : 1;
+
+	double incrementalScore = conference.getScore();
+	double score = scoreConference(conference, numberOfThreads);
+
+	double drift = fabs(getReportedScore(score - incrementalScore));
+	if(drift > worstScoreDrift)
+	{
+		worstScoreDrift = drift;
+		cout << "Worst score drift so far : " << drift << endl;
+	}
+	return drift;
+}
+
+void SessionOrganizer::auditBestScore()
+{
+	if(bestConference.getParallelTracks() == 0)
+		return;
+
+	auditScore(bestConference);
+	globalMaximumScore = bestConference.getScore();
+
+	// the threads compare their offers against the corrected score
+	vector<int> papers;
+	getSchedule(bestConference, papers);
+	incumbent.correctScore(papers, globalMaximumScore);
+	cout << "Optimality gap at most " << getOptimalityGap() * 100 << "%" << endl;
+}
+
+double SessionOrganizer::computeUpperBound(int numberOfThreads)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int sessionMates = papersInSession - 1;
+	int parallelMates = (parallelTracks - 1) * papersInSession;
+
+	vector<double> rowBounds(totalNumberOfPapers);
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		threads.push_back(thread([&, t]() {
+			vector<double> similarities(totalNumberOfPapers - 1);
+			vector<double> parallels(totalNumberOfPapers - 1);
+			for(int paper = t; paper < totalNumberOfPapers; paper += numberOfThreads){
+				// either entry of an asymmetric pair may be the one scored
+				int count = 0;
+				for(int other = 0; other < totalNumberOfPapers; other++){
+					if(other == paper)
+						continue;
+					double distance1 = getScoringDistance(paper, other);
+					double distance2 = getScoringDistance(other, paper);
+					similarities[count] = similarityWeight * (distanceOne - min(distance1, distance2));
+					parallels[count] = parallelWeight * max(distance1, distance2);
+					count++;
+				}
+
+				// the best pairs of each kind, a pair may be counted as both
+				nth_element(similarities.begin(), similarities.begin() + sessionMates, similarities.end(), greater<double>());
+				nth_element(parallels.begin(), parallels.begin() + parallelMates, parallels.end(), greater<double>());
+				CompensatedSum bound;
+				for(int i = 0; i < sessionMates; i++)
+					bound.add(similarities[i]);
+				for(int i = 0; i < parallelMates; i++)
+					bound.add(parallels[i]);
+				rowBounds[paper] = bound.getSum();
+			}
+		}));
+	}
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+	}
+
+	// every pair is counted from both of its papers
+	CompensatedSum bound;
+	for(int paper = 0; paper < totalNumberOfPapers; paper++)
+		bound.add(rowBounds[paper]);
+	return bound.getSum() / 2;
+}
+
+InstanceStatistics& SessionOrganizer::getInstanceStatistics()
+{
+	return statistics;
+}
+
+double SessionOrganizer::getOptimalityGap()
+{
+	double score = bestConference.getParallelTracks() > 0 ? bestConference.getScore() : conference->getScore();
+	if(upperBound == 0.0)
+		return score == 0.0 ? 0.0 : 1.0;
+	return max(0.0, (upperBound - score) / fabs(upperBound));
+}
+
+bool SessionOrganizer::isGapClosed()
+{
+	if(gapThreshold <= 0.0 || getOptimalityGap() > gapThreshold)
+		return false;
+
+	cout << "Optimality gap " << getOptimalityGap() * 100 << "% is below " << gapThreshold * 100 << "%, stopping" << endl;
+	return true;
+}
+
+void SessionOrganizer::printSessionOrganiser()
+{
+	conference->printConference();
+}
+
+double SessionOrganizer::getConferenceScore()
+{
+	return getReportedScore(conference->getScore());
+}
+
+void SessionOrganizer::initializeOrganization(Conference *conference)
+{
+	
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	vector<int> v;
+	for(int i=0; i<totalNumberOfPapers; i++){
+		v.push_back(i);
+	}
+
+	std::random_shuffle(v.begin(),v.end());
+
+	int paperCounter = 0;
+	for(int i = 0; i < conference->getSessionsInTrack(); i++)
+	{
+		for(int j = 0; j < conference->getParallelTracks(); j++)
+		{
+			for(int k = 0; k < conference->getPapersInSession(); k++)
+			{
+				conference->setPaper(j, i, k, v[paperCounter]);
+				paperCounter++;
+			}
+		}
+	}
+
+	mt19937 generator(rand());
+	repairConstraints(*conference, generator);
+
+	// update the score
+	double score = scoreConference(*conference);
+}
+
+void SessionOrganizer::swapPapers(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
+{
+	int paper1 = conference.getPaper(trackIndex1, sessionIndex1, paperIndex1);
+	int paper2 = conference.getPaper(trackIndex2, sessionIndex2, paperIndex2);
+	
+	double delta = 0.0;
+	delta -= getSimilarityScoreForSession(conference, trackIndex1, sessionIndex1);
+	delta -= getSimilarityScoreForSession(conference, trackIndex2, sessionIndex2);
+	delta -= parallelWeight * getParallelScoreForSession(conference, trackIndex1, sessionIndex1);
+	delta -= parallelWeight * getParallelScoreForSession(conference, trackIndex2, sessionIndex2);
+
+	if(sessionIndex1 == sessionIndex2)
+	{
+		delta += parallelWeight * getParallelScoreBetweenSessions(conference, trackIndex1, sessionIndex1, trackIndex2, sessionIndex2);
+	}
+
+	conference.setPaper(trackIndex1,sessionIndex1,paperIndex1,paper2);
+	conference.setPaper(trackIndex2,sessionIndex2,paperIndex2,paper1);
+
+	delta += getSimilarityScoreForSession(conference, trackIndex1, sessionIndex1);
+	delta += getSimilarityScoreForSession(conference, trackIndex2, sessionIndex2);
+	delta += parallelWeight * getParallelScoreForSession(conference, trackIndex1, sessionIndex1);
+	delta += parallelWeight * getParallelScoreForSession(conference, trackIndex2, sessionIndex2);
+	
+	if(sessionIndex1 == sessionIndex2)
+	{
+		delta -= parallelWeight * getParallelScoreBetweenSessions(conference, trackIndex1, sessionIndex1, trackIndex2, sessionIndex2);
+	}
+
+	conference.increaseScore(delta);
+}
+
+void SessionOrganizer::swapTwoRandomPapers(Conference *conference) {
+	
+	int trackIndex1 = rand() % parallelTracks ;
+	int trackIndex2 = rand() % parallelTracks ;
+
+	int sessionIndex1 = rand() % sessionsInTrack;
+	int sessionIndex2 = rand() % sessionsInTrack;
+
+	if(trackIndex1 == trackIndex2) {
+		// sessions must be different if both tracks are same
+		if(sessionIndex1 == sessionIndex2) {
+			if(sessionsInTrack == 1) {
+				// change the track
+				do { 
+					trackIndex2 = rand() % parallelTracks;
+				} while (trackIndex1 == trackIndex2);
+			}else {
+				// change the session
+				do {
+					sessionIndex2 = rand() % sessionsInTrack;
+				} while (sessionIndex1 == sessionIndex2);
+			}
+		}
+	}
+
+	int paperIndex1 = rand() % papersInSession;
+	int paperIndex2 = rand() % papersInSession;
+
+	// swaps that break a constraint are drawn again, a few times
+	mt19937 generator(rand());
+	for(int attempt = 0; !isSwapFeasible(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2); attempt++) {
+		if(attempt == CONSTRAINT_REPAIR_ATTEMPTS)
+			return;
+		pickRandomSlots(generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+	}
+
+	swapPapers(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+}
+
+/**
+ * The constraints a partner in one session breaks for a paper in another.
+ */
+static int countBrokenConstraints(bool conflict, bool apart, int partnerTrack, int partnerSession, int trackIndex, int sessionIndex)
+{
+	if(partnerSession != sessionIndex)
+		return 0;
+	return partnerTrack == trackIndex ? apart : conflict;
+}
+
+bool SessionOrganizer::isMoveFeasible(Conference &conference, const int *papers, const PaperSlot *destinations, int numberOfPapers)
+{
+	// the conference counts where the partners of every constrained paper are
+	if(conference.getConstraints() != &constraints)
+		conference.setConstraints(&constraints);
+
+	for(int i = 0; i < numberOfPapers; i++)
+	{
+		int paper = papers[i];
+		if(!constraints.isConstrained(paper))
+			continue;
+
+		int trackIndex = destinations[i].trackIndex;
+		int sessionIndex = destinations[i].sessionIndex;
+		if(!constraints.isSlotAllowed(paper, sessionIndex))
+			return false;
+
+		// partners that move too are counted at their destinations instead
+		int broken = conference.getBrokenConstraints(paper, trackIndex, sessionIndex);
+		for(int j = 0; j < numberOfPapers; j++)
+		{
+			int partner = papers[j];
+			if(j == i || !constraints.isConstrained(partner))
+				continue;
+
+			bool conflict = constraints.isConflict(paper, partner);
+			bool apart = constraints.isApart(paper, partner);
+			if(!conflict && !apart)
+				continue;
+
+			int partnerTrack, partnerSession, partnerIndex;
+			if(conference.getPaperLocation(partner, partnerTrack, partnerSession, partnerIndex))
+				broken -= countBrokenConstraints(conflict, apart, partnerTrack, partnerSession, trackIndex, sessionIndex);
+			broken += countBrokenConstraints(conflict, apart, destinations[j].trackIndex, destinations[j].sessionIndex, trackIndex, sessionIndex);
+		}
+		if(broken > 0)
+			return false;
+	}
+	return true;
+}
+
+bool SessionOrganizer::isSwapFeasible(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
+{
+	if(!constraints.hasConstraints())
+		return true;
+
+	int papers[2] = { conference.getPaper(trackIndex1, sessionIndex1, paperIndex1), conference.getPaper(trackIndex2, sessionIndex2, paperIndex2) };
+	if(!constraints.isConstrained(papers[0]) && !constraints.isConstrained(papers[1]))
+		return true;
+
+	PaperSlot destinations[2] = { { trackIndex2, sessionIndex2, paperIndex2 }, { trackIndex1, sessionIndex1, paperIndex1 } };
+	return isMoveFeasible(conference, papers, destinations, 2);
+}
+
+bool SessionOrganizer::isRotationFeasible(Conference &conference, const PaperSlot *slots, int numberOfSlots)
+{
+	if(!constraints.hasConstraints())
+		return true;
+
+	// the paper of every slot moves to the next one, the last to the first
+	int papers[MAX_CHAIN_LENGTH];
+	PaperSlot destinations[MAX_CHAIN_LENGTH];
+	bool anyConstrained = false;
+	for(int i = 0; i < numberOfSlots; i++)
+	{
+		papers[i] = conference.getPaper(slots[i].trackIndex, slots[i].sessionIndex, slots[i].paperIndex);
+		destinations[i] = slots[(i + 1) % numberOfSlots];
+		anyConstrained = anyConstrained || constraints.isConstrained(papers[i]);
+	}
+	return !anyConstrained || isMoveFeasible(conference, papers, destinations, numberOfSlots);
+}
+
+bool SessionOrganizer::isConferenceFeasible(Conference &conference)
+{
+	const vector<int> &papers = constraints.getConstrainedPapers();
+	for(int i = 0; i < papers.size(); i++)
+	{
+		PaperSlot slot;
+		if(conference.getPaperLocation(papers[i], slot.trackIndex, slot.sessionIndex, slot.paperIndex) && !isMoveFeasible(conference, &papers[i], &slot, 1))
+			return false;
+	}
+	return true;
+}
+
+int SessionOrganizer::repairConstraints(Conference &conference, mt19937 &generator)
+{
+	// a paper moved out of the way may free the slot another paper needs,
+	// so the papers left are tried again in a few passes
+	int violations = 0;
+	const vector<int> &papers = constraints.getConstrainedPapers();
+	for(int pass = 0; pass < CONSTRAINT_REPAIR_PASSES && (pass == 0 || violations > 0); pass++)
+	{
+		violations = 0;
+		for(int i = 0; i < papers.size(); i++)
+		{
+			PaperSlot slot;
+			if(!conference.getPaperLocation(papers[i], slot.trackIndex, slot.sessionIndex, slot.paperIndex) || isMoveFeasible(conference, &papers[i], &slot, 1))
+				continue;
+
+			// the paper, or now and then a partner in its way, is swapped
+			// with a random paper where both swapped papers are allowed
+			const vector<int> &conflicts = constraints.getConflicts(papers[i]);
+			const vector<int> &apart = constraints.getApart(papers[i]);
+			int numberOfPartners = conflicts.size() + apart.size();
+			bool feasible = false;
+			for(int attempt = 0; attempt < CONSTRAINT_REPAIR_ATTEMPTS && !feasible; attempt++)
+			{
+				PaperSlot from = slot;
+				if(numberOfPartners > 0 && generator() % 2 == 0)
+				{
+					int j = generator() % numberOfPartners;
+					int partner = j < conflicts.size() ? conflicts[j] : apart[j - conflicts.size()];
+					if(!conference.getPaperLocation(partner, from.trackIndex, from.sessionIndex, from.paperIndex))
+						continue;
+				}
+
+				int trackIndex = generator() % parallelTracks;
+				int sessionIndex = generator() % sessionsInTrack;
+				int paperIndex = generator() % papersInSession;
+				if(trackIndex == from.trackIndex && sessionIndex == from.sessionIndex)
+					continue;
+
+				if(isSwapFeasible(conference, from.trackIndex, from.sessionIndex, from.paperIndex, trackIndex, sessionIndex, paperIndex))
+				{
+					swapPapers(conference, from.trackIndex, from.sessionIndex, from.paperIndex, trackIndex, sessionIndex, paperIndex);
+					conference.getPaperLocation(papers[i], slot.trackIndex, slot.sessionIndex, slot.paperIndex);
+					feasible = isMoveFeasible(conference, &papers[i], &slot, 1);
+				}
+			}
+			if(!feasible)
+				violations++;
+		}
+	}
+
+	if(violations > 0)
+		cout << "Unable to meet the constraints of " << violations << " papers" << endl;
+	return violations;
+}
+
+double SessionOrganizer::getScoreOnSwapping(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
+{
+	// swaps that break a constraint are rejected before they are scored
+	if(!isSwapFeasible(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2))
+		return INFEASIBLE_SCORE;
+
+	// first swap papers
+	swapPapers(conference,trackIndex1,sessionIndex1,paperIndex1,trackIndex2,sessionIndex2,paperIndex2);
+	
+	// calculate the resulting score
+	double score = conference.getScore();
+	
+	// now unswap
+	swapPapers(conference,trackIndex1,sessionIndex1,paperIndex1,trackIndex2,sessionIndex2,paperIndex2);
+	
+	return score;
+}
+
+bool SessionOrganizer::greedyStep()
+{
+	double currentMaximumScore = conference->getScore();
+	//cout<<"Current Score = "<<currentMaximumScore<<endl;
+	bool increased = false;
+	int optimalTrackIndex1,optimalTrackIndex2;
+	int optimalSessionIndex1,optimalSessionIndex2;
+	int optimalPaperIndex1,optimalPaperIndex2;
+
+	for(int trackIndex1=0; trackIndex1<parallelTracks; ++trackIndex1)
+	{
+
+		for(int sessionIndex1=0; sessionIndex1<sessionsInTrack; ++sessionIndex1)
+		{
+			
+			for(int trackIndex2=trackIndex1; trackIndex2<parallelTracks; ++trackIndex2)
+			{
+				
+				int sessionIndex2;
+				if(trackIndex1 == trackIndex2){
+					sessionIndex2 = sessionIndex1 + 1;
+				}else{
+					sessionIndex2 = 0;
+				}
+
+				for(sessionIndex2 ; sessionIndex2<sessionsInTrack; ++sessionIndex2)
+				{
+					
+					for(int paperIndex1=0; paperIndex1<papersInSession; ++paperIndex1){
+						int index1 = paperIndex1;
+						//int index1 = rand() % papersInSession;
+
+						// a few random partners in the other session
+						for(int sample = 0; sample < greedySamples; sample++){
+							int index2 = rand() % papersInSession;
+							double newScore = getScoreOnSwapping(*conference,trackIndex1,sessionIndex1,index1,trackIndex2,sessionIndex2,index2);
+							//cout<<"New Score = "<<newScore<<endl;
+							if(newScore > currentMaximumScore) {
+								// save indexes
+								increased = true;
+								currentMaximumScore = newScore;
+								optimalTrackIndex1 = trackIndex1; optimalTrackIndex2 = trackIndex2;
+								optimalSessionIndex1 = sessionIndex1; optimalSessionIndex2 = sessionIndex2;
+								optimalPaperIndex1 = index1; optimalPaperIndex2 = index2;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if(increased){
+		swapPapers(*conference,optimalTrackIndex1,optimalSessionIndex1,optimalPaperIndex1,optimalTrackIndex2,optimalSessionIndex2,optimalPaperIndex2);
+		//cout << conference->getScore() << endl;
+	}else{
+		;//cout<<"Reached Local Maxima"<<endl;
+	}
+
+	return increased;
+}
+
+/*
+ * Swap papers only in time slot
+ */
+bool SessionOrganizer::greedyStep2()
+{
+	double currentMaximumScore = conference->getScore();
+	//cout<<"Current Score = "<<currentMaximumScore<<endl;
+	bool increased = false;
+	int optimalTrackIndex1,optimalTrackIndex2;
+	int optimalSessionIndex1;
+	int optimalPaperIndex1,optimalPaperIndex2;
+
+	for(int sessionIndex1=0; sessionIndex1<sessionsInTrack; ++sessionIndex1)
+	{
+		for(int trackIndex1=0; trackIndex1<parallelTracks; ++trackIndex1)
+		{
+
+			for(int trackIndex2=trackIndex1+1; trackIndex2<parallelTracks; ++trackIndex2)
+			{
+
+				for(int paperIndex1=0; paperIndex1<papersInSession; ++paperIndex1){
+					int index1 = paperIndex1;
+
+					for(int index2 = 0; index2<papersInSession; index2++){
+						double newScore = getScoreOnSwapping(*conference,trackIndex1,sessionIndex1,index1,trackIndex2,sessionIndex1,index2);
+						
+						if(newScore > currentMaximumScore) {
+							// save indexes
+							increased = true;
+							currentMaximumScore = newScore;
+							optimalTrackIndex1 = trackIndex1; optimalTrackIndex2 = trackIndex2;
+							optimalSessionIndex1 = sessionIndex1;
+							optimalPaperIndex1 = index1; optimalPaperIndex2 = index2;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if(increased){
+		swapPapers(*conference,optimalTrackIndex1,optimalSessionIndex1,optimalPaperIndex1,optimalTrackIndex2,optimalSessionIndex1,optimalPaperIndex2);
+	}else{
+		;//cout<<"Reached Local Maxima"<<endl;
+	}
+
+	return increased;
+}
+
+void SessionOrganizer::randomSwapping(int maximumIterations){
+
+	if(canBatchSwaps()){
+		SwapBatch batch;
+		for(int iterations = 0; iterations < maximumIterations; ){
+			int moves = min(SWAP_BATCH_SIZE, maximumIterations - iterations);
+			if(batchSwapStep(*conference, randomGenerator, batch, moves, false))
+				iterations = 0;
+			else
+				iterations += moves;
+		}
+		return;
+	}
+
+	double maximumScore = conference->getScore();
+	int iterations = 0;
+
+	for(; iterations < maximumIterations ; iterations++){
+		int trackIndex1 = rand() % parallelTracks ;
+		int trackIndex2 = rand() % parallelTracks ;
+
+		int sessionIndex1 = rand() % sessionsInTrack;
+		int sessionIndex2 = rand() % sessionsInTrack;
+
+		if(trackIndex1 == trackIndex2) {
+			// sessions must be different if both tracks are same
+			if(sessionIndex1 == sessionIndex2) {
+				if(sessionsInTrack == 1) {
+					// change the track
+					do { 
+						trackIndex2 = rand() % parallelTracks;
+					} while (trackIndex1 == trackIndex2);
+				}else {
+					// change the session
+					do {
+						sessionIndex2 = rand() % sessionsInTrack;
+					} while (sessionIndex1 == sessionIndex2);
+				}
+			}
+		}
+
+		int paperIndex1 = rand() % papersInSession;
+		int paperIndex2 = rand() % papersInSession;
+
+		double score = getScoreOnSwapping(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+
+		if(score > maximumScore){
+			iterations = 0;
+			maximumScore = score;
+			swapPapers(*conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		}
+	}
+}
+
+void SessionOrganizer::pickRandomSlots(mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2)
+{
+	trackIndex1 = generator() % parallelTracks;
+	trackIndex2 = generator() % parallelTracks;
+
+	sessionIndex1 = generator() % sessionsInTrack;
+	sessionIndex2 = generator() % sessionsInTrack;
+
+	if(trackIndex1 == trackIndex2 && sessionIndex1 == sessionIndex2) {
+		// sessions must be different if both tracks are same
+		if(sessionsInTrack == 1) {
+			do {
+				trackIndex2 = generator() % parallelTracks;
+			} while (trackIndex1 == trackIndex2);
+		}else {
+			do {
+				sessionIndex2 = generator() % sessionsInTrack;
+			} while (sessionIndex1 == sessionIndex2);
+		}
+	}
+
+	paperIndex1 = generator() % papersInSession;
+	paperIndex2 = generator() % papersInSession;
+}
+
+void SessionOrganizer::kickConference(Conference &conference, int numberOfSwaps, mt19937 &generator)
+{
+	for(int i = 0; i < numberOfSwaps; i++){
+		int trackIndex1, sessionIndex1, paperIndex1;
+		int trackIndex2, sessionIndex2, paperIndex2;
+		pickRandomSlots(generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		if(isSwapFeasible(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2))
+			swapPapers(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+	}
+}
+
+bool SessionOrganizer::proposeCandidateSwap(Conference &conference, mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int listSize = candidateLists.getListSize();
+	if(listSize == 0 || papersInSession == 1)
+		return false;
+
+	int paper = generator() % totalNumberOfPapers;
+	int trackIndex, sessionIndex, paperIndex;
+	conference.getPaperLocation(paper, trackIndex, sessionIndex, paperIndex);
+
+	if(parallelTracks == 1 || generator() % 2 == 0){
+		// the paper takes the place of another paper in the session of a similar paper
+		int similarPaper = candidateLists.getSimilarPapers(paper)[generator() % listSize];
+		conference.getPaperLocation(similarPaper, trackIndex2, sessionIndex2, paperIndex2);
+		if(trackIndex2 == trackIndex && sessionIndex2 == sessionIndex)
+			return false;
+
+		int index = generator() % (papersInSession - 1);
+		paperIndex2 = index < paperIndex2 ? index : index + 1;
+
+		trackIndex1 = trackIndex; sessionIndex1 = sessionIndex; paperIndex1 = paperIndex;
+		return true;
+	}
+
+	// a dissimilar paper moves into a random session parallel to the paper
+	int dissimilarPaper = candidateLists.getDissimilarPapers(paper)[generator() % listSize];
+	conference.getPaperLocation(dissimilarPaper, trackIndex1, sessionIndex1, paperIndex1);
+	if(sessionIndex1 == sessionIndex && trackIndex1 != trackIndex)
+		return false;
+
+	trackIndex2 = generator() % (parallelTracks - 1);
+	if(trackIndex2 >= trackIndex)
+		trackIndex2++;
+	sessionIndex2 = sessionIndex;
+	paperIndex2 = generator() % papersInSession;
+	return true;
+}
+
+void SessionOrganizer::pickSwap(Conference &conference, mt19937 &generator, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2)
+{
+	if(generator() % 100 < CANDIDATE_SWAP_PERCENT && proposeCandidateSwap(conference, generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2))
+		return;
+
+	pickRandomSlots(generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+}
+
+bool SessionOrganizer::canBatchSwaps()
+{
+	return statistics.isValid() && statistics.isSymmetric();
+}
+
+void SessionOrganizer::evaluateSwapBatch(Conference &conference, SwapBatch &batch)
+{
+	// the batch works on the distances, in the units of the scores
+	if(canBatchSwaps() && quantizedMatrix.getScale() > 0){
+		batch.evaluate(conference, quantizedMatrix, similarityWeight, parallelWeight);
+		return;
+	}
+	if(canBatchSwaps()){
+		batch.evaluate(conference, distanceMatrix, similarityWeight, parallelWeight);
+		return;
+	}
+
+	int trackIndex1, sessionIndex1, paperIndex1;
+	int trackIndex2, sessionIndex2, paperIndex2;
+	for(int move = 0; move < batch.getNumberOfMoves(); move++){
+		batch.getMove(move, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		batch.setDelta(move, getScoreOnSwapping(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2) - conference.getScore());
+	}
+}
+
+bool SessionOrganizer::batchSwapStep(Conference &conference, mt19937 &generator, SwapBatch &batch, int numberOfMoves, bool candidates)
+{
+	int trackIndex1, sessionIndex1, paperIndex1;
+	int trackIndex2, sessionIndex2, paperIndex2;
+
+	batch.clear();
+	for(int i = 0; i < numberOfMoves; i++){
+		if(candidates)
+			pickSwap(conference, generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		else
+			pickRandomSlots(generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		if(isSwapFeasible(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2))
+			batch.addMove(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+	}
+
+	evaluateSwapBatch(conference, batch);
+	int best = batch.getBestMove();
+	if(best < 0 || batch.getDelta(best) <= 0)
+		return false;
+
+	// the batch adds up the distances in another order, the move is scored again
+	batch.getMove(best, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+	if(getScoreOnSwapping(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2) <= conference.getScore())
+		return false;
+
+	swapPapers(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+	return true;
+}
+
+double SessionOrganizer::getScoreOfSessions(Conference &conference, const PaperSlot *slots, int numberOfSlots)
+{
+	// the distinct sessions holding the slots
+	PaperSlot sessions[MAX_CHAIN_LENGTH];
+	int numberOfSessions = 0;
+	for(int i = 0; i < numberOfSlots; i++){
+		bool seen = false;
+		for(int j = 0; j < numberOfSessions && !seen; j++){
+			seen = sessions[j].trackIndex == slots[i].trackIndex && sessions[j].sessionIndex == slots[i].sessionIndex;
+		}
+		if(!seen)
+			sessions[numberOfSessions++] = slots[i];
+	}
+
+	double score = 0.0;
+	for(int i = 0; i < numberOfSessions; i++){
+		score += getSimilarityScoreForSession(conference, sessions[i].trackIndex, sessions[i].sessionIndex);
+		score += parallelWeight * getParallelScoreForSession(conference, sessions[i].trackIndex, sessions[i].sessionIndex);
+
+		// parallel sessions both in the list were counted twice
+		for(int j = 0; j < i; j++){
+			if(sessions[j].sessionIndex == sessions[i].sessionIndex)
+				score -= parallelWeight * getParallelScoreBetweenSessions(conference, sessions[j].trackIndex, sessions[j].sessionIndex, sessions[i].trackIndex, sessions[i].sessionIndex);
+		}
+	}
+	return score;
+}
+
+void SessionOrganizer::movePapers(Conference &conference, const PaperSlot *slots, int numberOfSlots, bool backward)
+{
+	if(backward){
+		int first = conference.getPaper(slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex);
+		for(int i = 0; i < numberOfSlots - 1; i++){
+			int paper = conference.getPaper(slots[i + 1].trackIndex, slots[i + 1].sessionIndex, slots[i + 1].paperIndex);
+			conference.setPaper(slots[i].trackIndex, slots[i].sessionIndex, slots[i].paperIndex, paper);
+		}
+		conference.setPaper(slots[numberOfSlots - 1].trackIndex, slots[numberOfSlots - 1].sessionIndex, slots[numberOfSlots - 1].paperIndex, first);
+		return;
+	}
+
+	int last = conference.getPaper(slots[numberOfSlots - 1].trackIndex, slots[numberOfSlots - 1].sessionIndex, slots[numberOfSlots - 1].paperIndex);
+	for(int i = numberOfSlots - 1; i > 0; i--){
+		int paper = conference.getPaper(slots[i - 1].trackIndex, slots[i - 1].sessionIndex, slots[i - 1].paperIndex);
+		conference.setPaper(slots[i].trackIndex, slots[i].sessionIndex, slots[i].paperIndex, paper);
+	}
+	conference.setPaper(slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex, last);
+}
+
+double SessionOrganizer::rotatePapers(Conference &conference, const PaperSlot *slots, int numberOfSlots)
+{
+	double delta = -getScoreOfSessions(conference, slots, numberOfSlots);
+	movePapers(conference, slots, numberOfSlots, false);
+	delta += getScoreOfSessions(conference, slots, numberOfSlots);
+
+	conference.increaseScore(delta);
+	return delta;
+}
+
+double SessionOrganizer::getDeltaOnRotating(Conference &conference, const PaperSlot *slots, int numberOfSlots)
+{
+	if(!isRotationFeasible(conference, slots, numberOfSlots))
+		return INFEASIBLE_SCORE;
+
+	double delta = -getScoreOfSessions(conference, slots, numberOfSlots);
+	movePapers(conference, slots, numberOfSlots, false);
+	delta += getScoreOfSessions(conference, slots, numberOfSlots);
+	movePapers(conference, slots, numberOfSlots, true);
+	return delta;
+}
+
+bool SessionOrganizer::pickRotation(Conference &conference, mt19937 &generator, PaperSlot *slots)
+{
+	if(parallelTracks * sessionsInTrack < 3)
+		return false;
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int paper = generator() % totalNumberOfPapers;
+	conference.getPaperLocation(paper, slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex);
+
+	int listSize = candidateLists.getListSize();
+	if(listSize > 0 && generator() % 100 < CANDIDATE_SWAP_PERCENT){
+		int similarPaper = candidateLists.getSimilarPapers(paper)[generator() % listSize];
+		conference.getPaperLocation(similarPaper, slots[1].trackIndex, slots[1].sessionIndex, slots[1].paperIndex);
+		if(papersInSession > 1){
+			// displace a paper other than the similar one
+			int index = generator() % (papersInSession - 1);
+			slots[1].paperIndex = index < slots[1].paperIndex ? index : index + 1;
+		}
+	}else{
+		slots[1].trackIndex = generator() % parallelTracks;
+		slots[1].sessionIndex = generator() % sessionsInTrack;
+		slots[1].paperIndex = generator() % papersInSession;
+	}
+
+	slots[2].trackIndex = generator() % parallelTracks;
+	slots[2].sessionIndex = generator() % sessionsInTrack;
+	slots[2].paperIndex = generator() % papersInSession;
+
+	for(int i = 0; i < 3; i++){
+		for(int j = 0; j < i; j++){
+			if(slots[i].trackIndex == slots[j].trackIndex && slots[i].sessionIndex == slots[j].sessionIndex)
+				return false;
+		}
+	}
+	return true;
+}
+
+bool SessionOrganizer::ejectionChainStep(Conference &conference, mt19937 &generator)
+{
+	int listSize = candidateLists.getListSize();
+	if(listSize == 0 || papersInSession == 1)
+		return false;
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	PaperSlot slots[MAX_CHAIN_LENGTH];
+
+	int paper = generator() % totalNumberOfPapers;
+	conference.getPaperLocation(paper, slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex);
+
+	int length = 1;
+	int bestLength = 0;
+	double bestDelta = 0.0;
+
+	while(length < MAX_CHAIN_LENGTH){
+		// the moving paper goes to the session of a similar paper not yet in the chain
+		int similarPaper = candidateLists.getSimilarPapers(paper)[generator() % listSize];
+		PaperSlot &slot = slots[length];
+		conference.getPaperLocation(similarPaper, slot.trackIndex, slot.sessionIndex, slot.paperIndex);
+
+		bool inChain = false;
+		for(int i = 0; i < length && !inChain; i++){
+			inChain = slots[i].trackIndex == slot.trackIndex && slots[i].sessionIndex == slot.sessionIndex;
+		}
+		if(inChain)
+			break;
+
+		// and ejects the paper there least similar to it
+		int similarIndex = slot.paperIndex;
+		double maximumDistance = -1.0;
+		for(int i = 0; i < papersInSession; i++){
+			if(i == similarIndex)
+				continue;
+
+			int otherPaper = conference.getPaper(slot.trackIndex, slot.sessionIndex, i);
+			if(getScoringDistance(paper, otherPaper) > maximumDistance){
+				maximumDistance = getScoringDistance(paper, otherPaper);
+				slot.paperIndex = i;
+			}
+		}
+
+		paper = conference.getPaper(slot.trackIndex, slot.sessionIndex, slot.paperIndex);
+		length++;
+
+		// the ejected paper closes the chain by taking the first slot
+		double delta = getDeltaOnRotating(conference, slots, length);
+		if(delta > bestDelta){
+			bestDelta = delta;
+			bestLength = length;
+		}
+	}
+
+	if(bestLength == 0)
+		return false;
+
+	rotatePapers(conference, slots, bestLength);
+	return true;
+}
+
+void SessionOrganizer::randomSwapping(Conference &conference, int maximumIterations, mt19937 &generator)
+{
+	int trackIndex1, sessionIndex1, paperIndex1;
+	int trackIndex2, sessionIndex2, paperIndex2;
+	PaperSlot slots[3];
+	SwapBatch batch;
+	bool batched = canBatchSwaps();
+
+	MoveSampler sampler(SWAP_TIME_SHARE, ROTATION_TIME_SHARE, EJECTION_CHAIN_TIME_SHARE);
+
+	for(int iterations = 0; iterations < maximumIterations; iterations++){
+		MoveSampler::MoveType move = sampler.nextMove();
+		chrono::steady_clock::time_point moveStart = chrono::steady_clock::now();
+		bool improved = false;
+
+		if(move == MoveSampler::SWAP_MOVE && batched){
+			// a batch counts as one move of the sampler, and as its swaps towards the failures
+			int moves = min(SWAP_BATCH_SIZE, maximumIterations - iterations);
+			improved = batchSwapStep(conference, generator, batch, moves, true);
+			iterations += moves - 1;
+		}else if(move == MoveSampler::SWAP_MOVE){
+			pickSwap(conference, generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+
+			double score = getScoreOnSwapping(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+			if(score > conference.getScore()){
+				improved = true;
+				swapPapers(conference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+			}
+		}else if(move == MoveSampler::ROTATION_MOVE){
+			if(pickRotation(conference, generator, slots) && getDeltaOnRotating(conference, slots, 3) > 0){
+				improved = true;
+				rotatePapers(conference, slots, 3);
+			}
+		}else{
+			improved = ejectionChainStep(conference, generator);
+		}
+
+		sampler.recordMove(move, chrono::duration<double>(chrono::steady_clock::now() - moveStart).count());
+		if(improved)
+			iterations = 0;
+	}
+}
+
+void SessionOrganizer::initializeGreedyOrganization(Conference *conference)
+{
+	
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	map<int,bool> assigned;
+	for(int i=0;i<totalNumberOfPapers;i++)
+		assigned[i] = false;
+
+	// the distance of every paper to the unassigned papers, starting from the
+	// row sums, in the units of the scoring distances
+	vector<double> unassignedDistance(totalNumberOfPapers, 0.0);
+	for (int paperIndex1 = 0; paperIndex1 < totalNumberOfPapers; paperIndex1++){
+		if (statistics.isValid())
+			unassignedDistance[paperIndex1] = statistics.getRowSum(paperIndex1) * distanceOne;
+		else
+			for (int paperIndex2 = 0; paperIndex2 < totalNumberOfPapers; paperIndex2++)
+				unassignedDistance[paperIndex1] += getScoringDistance(paperIndex1, paperIndex2);
+	}
+
+	for(int i = 0; i < conference->getSessionsInTrack(); i++)
+	{
+		for(int j = 0; j < conference->getParallelTracks(); j++)
+		{
+			// find the most distant paper
+			double maximum_distance = -1;
+			int most_distant_paper_index;
+			for (int paperIndex1 = 0; paperIndex1 < totalNumberOfPapers; paperIndex1++){
+				
+				if (!assigned[paperIndex1]){
+					
+					double temp_distance = unassignedDistance[paperIndex1];
+
+					if (temp_distance > maximum_distance){
+						
+						maximum_distance = temp_distance;
+						most_distant_paper_index = paperIndex1;
+					}
+				}
+			}
+
+			// set the first paper of the session to be most distant paper
+			conference->setPaper(j, i, 0, most_distant_paper_index);
+			assigned[most_distant_paper_index] = true;
+			for (int paperIndex1 = 0; paperIndex1 < totalNumberOfPapers; paperIndex1++)
+				unassignedDistance[paperIndex1] -= getScoringDistance(paperIndex1, most_distant_paper_index);
+
+			for(int k = 1; k < conference->getPapersInSession(); k++)
+			{
+				// find the nearest paper for the session
+				double minimum_distance = INT_MAX;
+				int nearest_paper_index;
+	
+				for (int paperIndex2 = 0; paperIndex2 < totalNumberOfPapers; paperIndex2++){
+				
+					if (!assigned[paperIndex2]){
+
+						double temp_distance = 0;
+
+						for (int inSessionPaperIndex = 0; inSessionPaperIndex < k; inSessionPaperIndex++){
+							temp_distance += getScoringDistance(conference->getPaper(j, i, inSessionPaperIndex), paperIndex2);
+						}
+
+						if (temp_distance < minimum_distance){
+							minimum_distance = temp_distance;
+							nearest_paper_index = paperIndex2;
+						}
+					}
+				}
+
+				conference->setPaper(j, i, k, nearest_paper_index);
+				assigned[nearest_paper_index] = true;
+				for (int paperIndex1 = 0; paperIndex1 < totalNumberOfPapers; paperIndex1++)
+					unassignedDistance[paperIndex1] -= getScoringDistance(paperIndex1, nearest_paper_index);
+			}
+		}
+	}
+
+	// update the score
+	double score = scoreConference(*conference);
+}
+
+
+/*
+ * CPU time of the calling thread in microseconds
+ */
+static double getThreadMicroseconds()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+	return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+bool SessionOrganizer::climbStep() {
+	//cout << "---------------- Climbing Step ---------------------" << endl;
+
+	ClimbOperator op = (ClimbOperator)climbBandit.nextOperator();
+	double previousScore = conference->getScore();
+	double start = getThreadMicroseconds();
+
+	bool increased = applyClimbOperator(op);
+
+	climbBandit.recordOperator(op, conference->getScore() - previousScore, getThreadMicroseconds() - start);
+	return increased;
+}
+
+bool SessionOrganizer::applyClimbOperator(ClimbOperator op)
+{
+	double previousScore = conference->getScore();
+
+	if(op == GREEDY_OPERATOR)
+		return greedyStep();
+
+	if(op == TIME_SLOT_GREEDY_OPERATOR)
+		return parallelTracks > 1 && greedyStep2();
+
+	if(op == RANDOM_SWAPPING_OPERATOR)
+	{
+		randomSwapping(papersInSession * parallelTracks);
+		return conference->getScore() > previousScore;
+	}
+
+	// kick: swap two random papers and climb back, undone if no better
+	Conference saved = *conference;
+	swapTwoRandomPapers(conference);
+	randomSwapping(parallelTracks * sessionsInTrack * papersInSession);
+	if(conference->getScore() > previousScore)
+		return true;
+
+	*conference = saved;
+	return false;
+}
+
+// the organizer whose checkpoint is deleted when the process exits, as the searches end with exit()
+static SessionOrganizer *checkpointedOrganizer = NULL;
+
+static void removeCheckpointAtExit()
+{
+	if(checkpointedOrganizer != NULL)
+		checkpointedOrganizer->removeCheckpoint();
+}
+
+/**
+ * Organize Papers by using Random Restart Hill Climbing Algorithm
+ */
+void SessionOrganizer::organizePapers()
+{
+	if(statistics.isValid())
+		cout << "Distances from " << statistics.getMinimumDistance() << " to " << statistics.getMaximumDistance()
+			<< (statistics.isSymmetric() ? ", symmetric" : ", not symmetric") << endl;
+	if(quantizedMatrix.getScale() > 0)
+		cout << "Scoring with " << quantizedMatrix.getBits() << " bit distances" << endl;
+
+	// the options are set, the fixed point matrix is all the search reads
+	releaseDistanceMatrix();
+
+	// a resumed search starts from the best conference of the checkpoint
+	bool resumed = resumeSearch && loadCheckpoint();
+
+	// a search that finishes leaves no checkpoint behind, only a killed one does
+	if(checkpointedOrganizer == NULL)
+		atexit(removeCheckpointAtExit);
+	checkpointedOrganizer = this;
+	bool warmStart = resumed || (!warmStartFileName.empty() && initializeWarmOrganization(this->conference));
+	if(!warmStart)
+		initializeOrganization(this->conference);
+	
+	globalMaximumScore = conference->getScore();
+	bestConference = *conference;
+	writeConference(*conference);
+
+	// check if there is only one track and one session
+	if (parallelTracks == 1 && sessionsInTrack == 1)
+		return;
+
+	upperBound = computeUpperBound(max(1u, thread::hardware_concurrency()));
+	cout << "Upper bound on the score : " << getReportedScore(upperBound) << endl;
+	if (isGapClosed())
+		return;
+
+	if (searchMode == "benchmark")
+	{
+		benchmarkScoring();
+		return;
+	}
+
+	if (searchMode == "exact" && exactSearch())
+		return;
+
+	if (searchMode == "memetic")
+	{
+		memeticSearch(50, warmStart);
+		return;
+	}
+
+	if (searchMode == "lns")
+	{
+		largeNeighbourhoodSearch();
+		return;
+	}
+
+	if (searchMode == "climb")
+	{
+		hillClimbSearch();
+		return;
+	}
+
+	if (searchMode == "portfolio")
+	{
+		portfolioSearch();
+		return;
+	}
+
+	// the first beam continues from the warm start schedule or the checkpointed beam
+	localBeamSearch(beamSize, warmStart);
+
+	while(true){
+		localBeamSearch(beamSize);
+	}
+}
+
+bool SessionOrganizer::isDistanceMatrixSymmetric()
+{
+	if(statistics.isValid())
+		return statistics.isSymmetric();
+
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		for(int j = i + 1; j < totalNumberOfPapers; j++)
+		{
+			if(getScoringDistance(i, j) != getScoringDistance(j, i))
+				return false;
+		}
+	}
+	return true;
+}
+
+bool SessionOrganizer::exactSearch()
+{
+	if(constraints.hasConstraints())
+	{
+		cout << "Exact search does not support constraints, using beam search" << endl;
+		return false;
+	}
+
+	if(parallelTracks * sessionsInTrack * papersInSession > EXACT_MAXIMUM_PAPERS)
+	{
+		cout << "Exact search takes at most " << EXACT_MAXIMUM_PAPERS << " papers, using beam search" << endl;
+		return false;
+	}
+
+	if(!isDistanceMatrixSymmetric())
+	{
+		cout << "Exact search needs a symmetric distance matrix, using beam search" << endl;
+		return false;
+	}
+
+	// a hill climbed organization gives the branch and bound a good incumbent
+	while(greedyStep());
+	double heuristicScore = conference->getScore();
+
+	// the solver works on the distances as read, which the scoring distances give back exactly
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	vector<double> distances(totalNumberOfPapers * totalNumberOfPapers);
+	vector<double*> rows(totalNumberOfPapers);
+	for(int i = 0; i < totalNumberOfPapers; i++)
+	{
+		rows[i] = &distances[i * totalNumberOfPapers];
+		for(int j = 0; j < totalNumberOfPapers; j++)
+			rows[i][j] = getScoringDistance(i, j) / distanceOne;
+	}
+	ExactSolver solver(&rows[0], parallelTracks, sessionsInTrack, papersInSession, tradeoffCoefficient);
+	conference->increaseScore(getReportedScore(heuristicScore) - heuristicScore);
+	double time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
+	bool optimal = solver.solve(*conference, time_left - 1.0);
+
+	double score = scoreConference(*conference);
+	cout << (optimal ? "Optimal score : " : "Best score found, not proven optimal : ") << getReportedScore(score) << endl;
+	cout << "Hill climbing score : " << getReportedScore(heuristicScore) << " (gap " << getReportedScore(score - heuristicScore) << ")" << endl;
+	cout << "Nodes searched : " << solver.getNumberOfNodes() << endl;
+
+	if(score > globalMaximumScore){
+		globalMaximumScore = score;
+		bestConference = *conference;
+		writeConference(*conference);
+	}
+
+	return true;
+}
+
+int SessionOrganizer::getSessionDistance(Conference &conference1, Conference &conference2)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int distance = 0;
+
+	for(int paperId = 0; paperId < totalNumberOfPapers; paperId++)
+	{
+		int trackIndex1, sessionIndex1, paperIndex1;
+		int trackIndex2, sessionIndex2, paperIndex2;
+		conference1.getPaperLocation(paperId, trackIndex1, sessionIndex1, paperIndex1);
+		conference2.getPaperLocation(paperId, trackIndex2, sessionIndex2, paperIndex2);
+
+		// the mates of the paper in conference1 must share its session in conference2
+		Session *session = conference1.getSession(trackIndex1, sessionIndex1);
+		for(int i = 0; i < papersInSession; i++)
+		{
+			int trackIndex, sessionIndex, paperIndex;
+			conference2.getPaperLocation(session->getPaper(i), trackIndex, sessionIndex, paperIndex);
+			if(trackIndex != trackIndex2 || sessionIndex != sessionIndex2)
+			{
+				distance++;
+				break;
+			}
+		}
+	}
+
+	return distance;
+}
+
+void SessionOrganizer::crossoverConferences(Conference &parent1, Conference &parent2, Conference &child, mt19937 &generator)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	// whole time slots are inherited, or whole sessions if there is one time slot
+	vector<bool> fromParent2(parallelTracks * sessionsInTrack);
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			bool choice = generator() % 2;
+			if(sessionsInTrack > 1 && trackIndex > 0)
+				choice = fromParent2[sessionIndex];
+			fromParent2[trackIndex * sessionsInTrack + sessionIndex] = choice;
+		}
+	}
+
+	child = parent1;
+	vector<bool> taken(totalNumberOfPapers, false);
+
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			if(!fromParent2[trackIndex * sessionsInTrack + sessionIndex])
+				continue;
+
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				int paperId = parent2.getPaper(trackIndex, sessionIndex, paperIndex);
+				child.setPaper(trackIndex, sessionIndex, paperIndex, paperId);
+				taken[paperId] = true;
+			}
+		}
+	}
+
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+	{
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+		{
+			if(fromParent2[trackIndex * sessionsInTrack + sessionIndex])
+				continue;
+
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+			{
+				int paperId = child.getPaper(trackIndex, sessionIndex, paperIndex);
+				if(taken[paperId])
+					child.setPaper(trackIndex, sessionIndex, paperIndex, -1);
+				taken[paperId] = true;
+			}
+		}
+	}
+
+	repairOrganization(child);
+	scoreConference(child);
+	repairConstraints(child, generator);
+}
+
+void SessionOrganizer::memeticSearch(int populationSize, bool warmStart)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+	int numberOfChildren = max(numberOfThreads, populationSize / 2);
+
+	// failed swaps before the local search of a child stops
+	int localSearchIterations = 2 * totalNumberOfPapers;
+
+	// a child closer than this to a member only competes with that member
+	int minimumDistance = max(1, totalNumberOfPapers / 10);
+
+	// generations without a better child before the worse half is replaced
+	int maximumStagnantGenerations = 50;
+
+	vector<mt19937> generators;
+	for(int i = 0; i < numberOfThreads; i++){
+		generators.push_back(mt19937(rand()));
+	}
+
+	// a warm start schedule and a tenth of kicked copies of it seed the population
+	int warmMembers = warmStart ? max(1, populationSize / 10) : 0;
+	vector<Conference> population(populationSize, *conference);
+	for(int i = 0; i < populationSize; i++){
+		if(i >= warmMembers){
+			initializeOrganization(&population[i]);
+			continue;
+		}
+		for(int j = 0; j < i * MEMETIC_WARM_START_SWAPS; j++){
+			swapTwoRandomPapers(&population[i]);
+		}
+	}
+
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		threads.push_back(thread([&, t]() {
+			for(int i = t; i < populationSize; i += numberOfThreads){
+				randomSwapping(population[i], localSearchIterations, generators[t]);
+			}
+		}));
+	}
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+	}
+
+	double time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
+	double max_generation_time = 0;
+	int generation = 0;
+	int stagnantGenerations = 0;
+
+	vector<Conference> children(numberOfChildren);
+	vector<char> explored(numberOfChildren);
+
+	while(true){
+		time_t generation_start = time(0);
+
+		// build and improve the children in parallel
+		threads.clear();
+		for(int t = 0; t < numberOfThreads; t++){
+			threads.push_back(thread([&, t]() {
+				mt19937 &generator = generators[t];
+				for(int i = t; i < numberOfChildren; i += numberOfThreads){
+					// binary tournaments pick the parents
+					int candidate1 = generator() % populationSize, candidate2 = generator() % populationSize;
+					int parent1 = population[candidate1].getScore() > population[candidate2].getScore() ? candidate1 : candidate2;
+					candidate1 = generator() % populationSize, candidate2 = generator() % populationSize;
+					int parent2 = population[candidate1].getScore() > population[candidate2].getScore() ? candidate1 : candidate2;
+
+					// the children are first touched by the thread that builds them
+					if(generation == 0)
+						children[i] = *conference;
+
+					crossoverConferences(population[parent1], population[parent2], children[i], generator);
+
+					// children explored before are not improved again
+					explored[i] = visitedStates.insert(children[i].getHash());
+					if(!explored[i]){
+						randomSwapping(children[i], localSearchIterations, generator);
+						visitedStates.insert(children[i].getHash());
+					}
+				}
+			}));
+		}
+		for(int t = 0; t < numberOfThreads; t++){
+			threads[t].join();
+		}
+
+		bool improved = false;
+		for(int i = 0; i < numberOfChildren; i++){
+			if(explored[i])
+				continue;
+
+			int nearest = 0, worst = 0;
+			int nearestDistance = INT_MAX;
+			for(int j = 0; j < populationSize; j++){
+				int distance = getSessionDistance(children[i], population[j]);
+				if(distance < nearestDistance){
+					nearestDistance = distance;
+					nearest = j;
+				}
+				if(population[j].getScore() < population[worst].getScore()){
+					worst = j;
+				}
+			}
+
+			// clones are dropped, near clones compete with their nearest member
+			if(nearestDistance == 0)
+				continue;
+			int replaced = nearestDistance < minimumDistance ? nearest : worst;
+			if(children[i].getScore() <= population[replaced].getScore())
+				continue;
+			population[replaced] = children[i];
+
+			if(children[i].getScore() > globalMaximumScore){
+				improved = true;
+				globalMaximumScore = children[i].getScore();
+				bestConference = children[i];
+				*conference = children[i];
+				writeConference(children[i]);
+				cout << "Generation " << generation << " increased to " << getReportedScore(globalMaximumScore) << endl;
+			}
+		}
+
+		stagnantGenerations = improved ? 0 : stagnantGenerations + 1;
+		if(stagnantGenerations >= maximumStagnantGenerations){
+			// bring in new random conferences in place of the worse half
+			sort(population.begin(), population.end());
+			for(int i = 0; i < populationSize / 2; i++){
+				initializeOrganization(&population[i]);
+				randomSwapping(population[i], localSearchIterations, generators[0]);
+			}
+			stagnantGenerations = 0;
+		}
+
+		// an immigrant from another island takes the place of the worst member
+		Conference immigrant;
+		if(exchangeWithIslands(bestConference, immigrant)){
+			int worst = min_element(population.begin(), population.end()) - population.begin();
+			population[worst] = immigrant;
+			if(immigrant.getScore() > globalMaximumScore){
+				globalMaximumScore = immigrant.getScore();
+				bestConference = immigrant;
+				*conference = immigrant;
+				writeConference(immigrant);
+				cout << "Generation " << generation << " immigrant with score " << getReportedScore(globalMaximumScore) << endl;
+			}
+		}
+
+		// correct the scores kept by the local search against full rescores
+		if(isScoreAuditDue()){
+			for(int i = 0; i < populationSize; i++){
+				auditScore(population[i]);
+			}
+			auditBestScore();
+		}
+		saveCheckpoint();
+		generation++;
+
+		max_generation_time = max(max_generation_time, difftime(time(0), generation_start));
+		time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
+
+		if (time_left <= max_generation_time + 1.0 || isGapClosed()) {
+			return;
+		}
+	}
+}
+
+double SessionOrganizer::getPaperContribution(Conference &conference, int paperId)
+{
+	int trackIndex, sessionIndex, paperIndex;
+	if(!conference.getPaperLocation(paperId, trackIndex, sessionIndex, paperIndex))
+		return 0.0;
+
+	return getInsertionGain(conference, paperId, trackIndex, sessionIndex, paperIndex);
+}
+
+void SessionOrganizer::destroyPapers(Conference &conference, int numberOfPapers, DestroyHeuristic heuristic, mt19937 &generator, vector<int> &papers)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	vector<int> candidates;
+	for(int i = 0; i < totalNumberOfPapers; i++){
+		candidates.push_back(i);
+	}
+
+	if(heuristic == RANDOM_DESTROY){
+		shuffle(candidates.begin(), candidates.end(), generator);
+	}else if(heuristic == RELATED_DESTROY){
+		// a random paper and papers close to it, which may belong together
+		int seed = generator() % totalNumberOfPapers;
+		swap(candidates[0], candidates[seed]);
+		sort(candidates.begin() + 1, candidates.end(), [this, seed](int a, int b) { return getScoringDistance(seed, a) < getScoringDistance(seed, b); });
+		shuffle(candidates.begin() + 1, candidates.begin() + min(totalNumberOfPapers, 2 * numberOfPapers), generator);
+	}else{
+		// papers drawn from those contributing least
+		vector<double> contribution(totalNumberOfPapers);
+		for(int i = 0; i < totalNumberOfPapers; i++){
+			contribution[i] = getPaperContribution(conference, i);
+		}
+		sort(candidates.begin(), candidates.end(), [&contribution](int a, int b) { return contribution[a] < contribution[b]; });
+		shuffle(candidates.begin(), candidates.begin() + min(totalNumberOfPapers, 2 * numberOfPapers), generator);
+	}
+
+	papers.assign(candidates.begin(), candidates.begin() + numberOfPapers);
+	for(int i = 0; i < papers.size(); i++){
+		int trackIndex, sessionIndex, paperIndex;
+		conference.getPaperLocation(papers[i], trackIndex, sessionIndex, paperIndex);
+		conference.setPaper(trackIndex, sessionIndex, paperIndex, -1);
+	}
+}
+
+void SessionOrganizer::repairByAssignment(Conference &conference, vector<int> &papers)
+{
+	vector<int> emptyTracks, emptySessions, emptyPapers;
+	for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++){
+		for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++){
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++){
+				if(conference.getPaper(trackIndex, sessionIndex, paperIndex) < 0){
+					emptyTracks.push_back(trackIndex);
+					emptySessions.push_back(sessionIndex);
+					emptyPapers.push_back(paperIndex);
+				}
+			}
+		}
+	}
+
+	// gains are against the papers left in place, maximize their sum
+	vector< vector<double> > cost(papers.size(), vector<double>(emptyTracks.size()));
+	for(int i = 0; i < papers.size(); i++){
+		for(int slot = 0; slot < emptyTracks.size(); slot++){
+			cost[i][slot] = -getInsertionGain(conference, papers[i], emptyTracks[slot], emptySessions[slot], emptyPapers[slot]);
+
+			// against the papers left in place, the removed papers are checked by the caller
+			PaperSlot destination = { emptyTracks[slot], emptySessions[slot], emptyPapers[slot] };
+			if(!isMoveFeasible(conference, &papers[i], &destination, 1))
+				cost[i][slot] += INFEASIBLE_COST;
+		}
+	}
+
+	vector<int> assignment;
+	AssignmentSolver::solve(cost, assignment);
+
+	for(int i = 0; i < papers.size(); i++){
+		int slot = assignment[i];
+		conference.setPaper(emptyTracks[slot], emptySessions[slot], emptyPapers[slot], papers[i]);
+	}
+
+	scoreConference(conference);
+}
+
+void SessionOrganizer::benchmarkScoring()
+{
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+	double seconds = min(5.0, processingTimeInMinutes*60 - difftime(time(0), starting_time) - 1.0);
+
+	vector<long long> evaluations(numberOfThreads, 0);
+	vector<double> checksums(numberOfThreads, 0.0);
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		unsigned int seed = rand();
+		threads.push_back(thread([&, t, seed]() {
+			// the copy is first touched by this thread, so it lives on its node
+			Conference localConference = *conference;
+			mt19937 generator(seed);
+			long long count = 0;
+			double checksum = 0.0;
+
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			while(chrono::duration<double>(chrono::steady_clock::now() - start).count() < seconds){
+				for(int i = 0; i < 1024; i++){
+					int trackIndex1, sessionIndex1, paperIndex1;
+					int trackIndex2, sessionIndex2, paperIndex2;
+					pickRandomSlots(generator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+					checksum += getScoreOnSwapping(localConference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+				}
+				count += 1024;
+			}
+			evaluations[t] = count;
+			checksums[t] = checksum;
+		}));
+	}
+
+	long long totalEvaluations = 0;
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+		totalEvaluations += evaluations[t];
+	}
+
+	cout << "Scoring benchmark : memory policy " << MatrixAllocator::getPolicyName(memoryPolicy)
+		<< ", " << (quantizedMatrix.getScale() > 0 ? quantizedMatrix.getBits() : 64) << " bit distances"
+		<< ", " << MatrixAllocator::getNumberOfNodes() << " NUMA nodes, " << numberOfThreads << " threads : "
+		<< (seconds > 0 ? totalEvaluations / seconds : 0) << " swap evaluations per second" << endl;
+}
+
+void SessionOrganizer::largeNeighbourhoodSearch()
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+
+	// the number of papers removed by a step is drawn from this range
+	int minimumRemoved = min(3, totalNumberOfPapers);
+	int maximumRemoved = max(minimumRemoved, min(40, totalNumberOfPapers / 4));
+
+	mt19937 generator(rand());
+	randomSwapping(*conference, totalNumberOfPapers, generator);
+
+	Conference current = *conference;
+	mutex currentMutex;
+	atomic<bool> gapClosed(false);
+	if(current.getScore() > globalMaximumScore){
+		globalMaximumScore = current.getScore();
+		bestConference = current;
+		writeConference(current);
+	}
+	startIncumbent();
+
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		unsigned int seed = rand();
+		threads.push_back(thread([&, t, seed]() {
+			mt19937 generator(seed);
+			Conference candidate;
+			Conference immigrant;
+			vector<int> papers;
+			long long iterations = 0;
+
+			while(!gapClosed && difftime(time(0), starting_time) < processingTimeInMinutes*60 - 1.0){
+				{
+					lock_guard<mutex> lock(currentMutex);
+
+					// the first thread trades schedules with the other islands
+					if(t == 0 && exchangeWithIslands(current, immigrant) && immigrant.getScore() > current.getScore()){
+						current = immigrant;
+						cout << "Immigrant with score " << getReportedScore(current.getScore()) << endl;
+					}
+					candidate = current;
+				}
+				double previousScore = candidate.getScore();
+
+				int numberOfPapers = minimumRemoved + generator() % (maximumRemoved - minimumRemoved + 1);
+				DestroyHeuristic heuristic = (DestroyHeuristic)(generator() % NUMBER_OF_DESTROY_HEURISTICS);
+				destroyPapers(candidate, numberOfPapers, heuristic, generator, papers);
+				repairByAssignment(candidate, papers);
+				iterations++;
+
+				// states explored before by any engine are skipped
+				if(candidate.getScore() < previousScore || !isConferenceFeasible(candidate) || visitedStates.insert(candidate.getHash()))
+					continue;
+
+				// repairs that are no worse are kept, to move along plateaus
+				{
+					lock_guard<mutex> lock(currentMutex);
+					if(candidate.getScore() >= current.getScore())
+						current = candidate;
+				}
+				if(offerIncumbent(candidate))
+					cout << "Iteration " << iterations << " increased to " << getReportedScore(candidate.getScore()) << endl;
+			}
+		}));
+	}
+
+	// the main thread keeps the best conference, audits the kept scores and checks the gap
+	while(!gapClosed && difftime(time(0), starting_time) < processingTimeInMinutes*60 - 1.0){
+		this_thread::sleep_for(chrono::milliseconds(100));
+		takeIncumbent();
+		if(isScoreAuditDue()){
+			{
+				lock_guard<mutex> lock(currentMutex);
+				auditScore(current);
+			}
+			auditBestScore();
+		}
+		saveCheckpoint();
+		if(isGapClosed())
+			gapClosed = true;
+	}
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+	}
+
+	takeIncumbent();
+	*conference = bestConference;
+}
+
+void SessionOrganizer::hillClimbSearch()
+{
+	const char *operatorNames[NUMBER_OF_CLIMB_OPERATORS] = { "greedy", "time slot greedy", "random swapping", "random kick" };
+	Conference immigrant;
+	long long steps = 0;
+
+	while(difftime(time(0), starting_time) < processingTimeInMinutes*60 - 1.0){
+		if(exchangeWithIslands(*conference, immigrant) && immigrant.getScore() > conference->getScore()){
+			*conference = immigrant;
+			cout << "Immigrant with score " << getReportedScore(conference->getScore()) << endl;
+		}
+
+		if(isScoreAuditDue()){
+			auditScore(*conference);
+			auditBestScore();
+		}
+
+		saveCheckpoint();
+		climbStep();
+		steps++;
+
+		if(conference->getScore() > globalMaximumScore){
+			globalMaximumScore = conference->getScore();
+			bestConference = *conference;
+			writeConference(*conference);
+			cout << "Step " << steps << " increased to " << getReportedScore(globalMaximumScore) << endl;
+			if(isGapClosed())
+				break;
+		}
+	}
+
+	for(int i = 0; i < NUMBER_OF_CLIMB_OPERATORS; i++){
+		cout << "Operator " << operatorNames[i] << " : " << climbBandit.getTotalPlays(i) << " plays, "
+			<< getReportedScore(climbBandit.getGainRate(i)) << " score per microsecond" << endl;
+	}
+
+	*conference = bestConference;
+}
+
+void SessionOrganizer::portfolioStep(PortfolioEngine engine, Conference *currents, mutex *currentMutexes, mt19937 &generator, Conference &candidate)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	if(engine == CONSTRUCTION_ENGINE){
+		// a random conference, or a kicked greedy one, taken to its local optimum
+		bool greedy = generator() % 2 == 0;
+		candidate = Conference(parallelTracks, sessionsInTrack, papersInSession);
+		if(greedy){
+			initializeGreedyOrganization(&candidate);
+		}else{
+			vector<int> papers(totalNumberOfPapers);
+			for(int i = 0; i < totalNumberOfPapers; i++)
+				papers[i] = i;
+			shuffle(papers.begin(), papers.end(), generator);
+
+			int paperCounter = 0;
+			for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++){
+				for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++){
+					for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++){
+						candidate.setPaper(trackIndex, sessionIndex, paperIndex, papers[paperCounter++]);
+					}
+				}
+			}
+		}
+		repairConstraints(candidate, generator);
+		scoreConference(candidate);
+		if(greedy)
+			kickConference(candidate, PORTFOLIO_KICK_SWAPS, generator);
+		randomSwapping(candidate, totalNumberOfPapers, generator);
+	}else if(engine == CROSSOVER_ENGINE){
+		// the parents are the current conferences of two engines
+		int engine1 = generator() % NUMBER_OF_PORTFOLIO_ENGINES;
+		int engine2 = (engine1 + 1 + generator() % (NUMBER_OF_PORTFOLIO_ENGINES - 1)) % NUMBER_OF_PORTFOLIO_ENGINES;
+		Conference parent1, parent2;
+		{
+			lock_guard<mutex> lock(currentMutexes[engine1]);
+			parent1 = currents[engine1];
+		}
+		{
+			lock_guard<mutex> lock(currentMutexes[engine2]);
+			parent2 = currents[engine2];
+		}
+		crossoverConferences(parent1, parent2, candidate, generator);
+		randomSwapping(candidate, totalNumberOfPapers, generator);
+	}else{
+		{
+			lock_guard<mutex> lock(currentMutexes[engine]);
+			candidate = currents[engine];
+		}
+
+		if(engine == LNS_ENGINE){
+			int minimumRemoved = min(3, totalNumberOfPapers);
+			int maximumRemoved = max(minimumRemoved, min(40, totalNumberOfPapers / 4));
+			int numberOfPapers = minimumRemoved + generator() % (maximumRemoved - minimumRemoved + 1);
+
+			vector<int> papers;
+			destroyPapers(candidate, numberOfPapers, (DestroyHeuristic)(generator() % NUMBER_OF_DESTROY_HEURISTICS), generator, papers);
+			repairByAssignment(candidate, papers);
+		}else{
+			// iterated hill climbing: a small kick, then climb again
+			kickConference(candidate, PORTFOLIO_KICK_SWAPS, generator);
+			randomSwapping(candidate, totalNumberOfPapers, generator);
+		}
+	}
+
+	// conferences that are no worse are kept, to move along plateaus
+	lock_guard<mutex> lock(currentMutexes[engine]);
+	if(!isConferenceFeasible(candidate))
+		candidate = currents[engine];
+	else if(candidate.getScore() >= currents[engine].getScore())
+		currents[engine] = candidate;
+}
+
+void SessionOrganizer::allocatePortfolioTurns(vector<double> &credits, int numberOfTurns, vector<int> &turnsOfEngine)
+{
+	double totalCredit = 0.0;
+	for(int i = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++)
+		totalCredit += credits[i];
+
+	// the spare turns go by largest remainder of the shares
+	int spareTurns = numberOfTurns - NUMBER_OF_PORTFOLIO_ENGINES;
+	vector< pair<double, int> > remainders;
+	int given = 0;
+	turnsOfEngine.assign(NUMBER_OF_PORTFOLIO_ENGINES, 1);
+	for(int i = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++){
+		double share = totalCredit > 0.0 ? spareTurns * credits[i] / totalCredit : (double)spareTurns / NUMBER_OF_PORTFOLIO_ENGINES;
+		turnsOfEngine[i] += (int)share;
+		given += (int)share;
+		remainders.push_back(make_pair(share - (int)share, i));
+	}
+	sort(remainders.rbegin(), remainders.rend());
+	for(int i = 0; given < spareTurns; i++, given++){
+		turnsOfEngine[remainders[i].second]++;
+	}
+}
+
+void SessionOrganizer::portfolioSearch()
+{
+	const char *engineNames[NUMBER_OF_PORTFOLIO_ENGINES] = { "climb", "lns", "crossover", "construction" };
+
+	// one thread per core, the engines share them by turns
+	int numberOfThreads = max(1u, thread::hardware_concurrency());
+
+	Conference currents[NUMBER_OF_PORTFOLIO_ENGINES];
+	mutex currentMutexes[NUMBER_OF_PORTFOLIO_ENGINES];
+	atomic<int> improvements[NUMBER_OF_PORTFOLIO_ENGINES];
+	for(int i = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++){
+		currents[i] = *conference;
+		improvements[i] = 0;
+	}
+
+	vector<double> credits(NUMBER_OF_PORTFOLIO_ENGINES, 0.0);
+	vector<int> turnsOfEngine;
+	allocatePortfolioTurns(credits, PORTFOLIO_TURNS, turnsOfEngine);
+
+	vector< atomic<int> > engineOfTurn(PORTFOLIO_TURNS);
+	for(int i = 0, turn = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++){
+		for(int j = 0; j < turnsOfEngine[i]; j++)
+			engineOfTurn[turn++] = i;
+	}
+
+	startIncumbent();
+	atomic<bool> timeUp(false);
+	vector<thread> threads;
+	for(int t = 0; t < numberOfThreads; t++){
+		unsigned int seed = rand();
+		threads.push_back(thread([&, t, seed]() {
+			mt19937 generator(seed);
+			Conference candidate;
+
+			// the threads start at different turns, so every turn is taken as often
+			for(int turn = t % PORTFOLIO_TURNS; !timeUp; turn = (turn + 1) % PORTFOLIO_TURNS){
+				PortfolioEngine engine = (PortfolioEngine)engineOfTurn[turn].load();
+				portfolioStep(engine, currents, currentMutexes, generator, candidate);
+
+				if(offerIncumbent(candidate)){
+					improvements[engine]++;
+					cout << "Engine " << engineNames[engine] << " increased to " << getReportedScore(candidate.getScore()) << endl;
+				}
+			}
+		}));
+	}
+
+	// the controller hands out the threads every epoch
+	time_t epochStart = time(0);
+	while(difftime(time(0), starting_time) < processingTimeInMinutes*60 - 1.0){
+		this_thread::sleep_for(chrono::milliseconds(100));
+		if(difftime(time(0), epochStart) < PORTFOLIO_EPOCH_SECONDS)
+			continue;
+		epochStart = time(0);
+
+		for(int i = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++){
+			credits[i] = credits[i] * PORTFOLIO_CREDIT_DECAY + improvements[i].exchange(0);
+		}
+
+		vector<int> previousTurns = turnsOfEngine;
+		allocatePortfolioTurns(credits, PORTFOLIO_TURNS, turnsOfEngine);
+		if(turnsOfEngine != previousTurns){
+			cout << "Portfolio turns :";
+			for(int i = 0, turn = 0; i < NUMBER_OF_PORTFOLIO_ENGINES; i++){
+				cout << " " << engineNames[i] << " " << turnsOfEngine[i];
+				for(int j = 0; j < turnsOfEngine[i]; j++)
+					engineOfTurn[turn++] = i;
+			}
+			cout << endl;
+		}
+
+		takeIncumbent();
+		saveCheckpoint();
+
+		// an immigrant from another island continues in the climbing engine
+		Conference immigrant;
+		if(exchangeWithIslands(bestConference, immigrant)){
+			lock_guard<mutex> currentLock(currentMutexes[CLIMB_ENGINE]);
+			if(immigrant.getScore() > currents[CLIMB_ENGINE].getScore())
+				currents[CLIMB_ENGINE] = immigrant;
+		}
+
+		if(isScoreAuditDue())
+			auditBestScore();
+		if(isGapClosed())
+			break;
+	}
+
+	timeUp = true;
+	for(int t = 0; t < numberOfThreads; t++){
+		threads[t].join();
+	}
+
+	takeIncumbent();
+	*conference = bestConference;
+}
+
+void SessionOrganizer::writeConference(Conference &conference) {
+	vector<int> papers;
+	getSchedule(conference, papers);
+	writeSchedule(papers, conference.getScore());
+}
+
+void SessionOrganizer::writeSchedule(const vector<int> &papers, double score) {
+	if(island.isAttached()){
+		island.publishIncumbent(papers, getReportedScore(score));
+	}
+
+	ofstream fout(outputFileName);
+
+	for(int sessionIndex = 0; sessionIndex < sessionsInTrack; sessionIndex++)
+    {
+        for(int trackIndex = 0; trackIndex < parallelTracks; trackIndex++)
+        {	
+        	const int *sessionPapers = &papers[(trackIndex * sessionsInTrack + sessionIndex) * papersInSession];
+            for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+            {
+                fout<< sessionPapers[paperIndex] << " ";
+            }
+            if(trackIndex != parallelTracks - 1)
+            {
+                fout<< "| ";
+            }
+        }
+        fout<< "\n";
+    }
+}
+
+void SessionOrganizer::startIncumbent()
+{
+	vector<int> papers;
+	getSchedule(bestConference.getParallelTracks() > 0 ? bestConference : *conference, papers);
+	incumbent.init(papers, globalMaximumScore);
+	takenIncumbentVersion = incumbent.getVersion();
+	incumbent.setListener([this](const vector<int> &papers, double score) {
+		writeSchedule(papers, score);
+	});
+}
+
+bool SessionOrganizer::offerIncumbent(Conference &conference)
+{
+	// nearly every offer loses, and is turned away before the schedule is copied
+	if(conference.getScore() <= incumbent.getScore())
+		return false;
+
+	vector<int> papers;
+	getSchedule(conference, papers);
+	return incumbent.offer(papers, conference.getScore());
+}
+
+void SessionOrganizer::takeIncumbent()
+{
+	if(incumbent.getVersion() == takenIncumbentVersion)
+		return;
+
+	vector<int> papers;
+	double score;
+	takenIncumbentVersion = incumbent.read(papers, score);
+	if(score > globalMaximumScore && setSchedule(papers, bestConference))
+		globalMaximumScore = bestConference.getScore();
+}
+
+string SessionOrganizer::getCheckpointFileName()
+{
+	return outputFileName + ".checkpoint";
+}
+
+void SessionOrganizer::removeCheckpoint()
+{
+	checkpoint.remove(getCheckpointFileName());
+}
+
+void SessionOrganizer::saveCheckpoint(vector<Conference> *beam, Conference *optimalConference, int iterations)
+{
+	// the buffer is filled here, the file is written by the checkpoint's own thread
+	if(difftime(time(0), lastCheckpointTime) < CHECKPOINT_SECONDS)
+		return;
+	lastCheckpointTime = time(0);
+
+	vector<int> papers;
+	ostringstream generatorState;
+	generatorState << randomGenerator;
+
+	checkpoint.clear();
+	checkpoint.putInteger(parallelTracks);
+	checkpoint.putInteger(sessionsInTrack);
+	checkpoint.putInteger(papersInSession);
+	checkpoint.putDouble(tradeoffCoefficient);
+	checkpoint.putString(searchMode);
+	checkpoint.putDouble(difftime(time(0), starting_time));
+	checkpoint.putString(generatorState.str());
+	checkpoint.putInteger(numberOfRestarts);
+
+	getSchedule(bestConference, papers);
+	checkpoint.putPapers(papers);
+
+	checkpoint.putInteger(elitePool.size());
+	for(int i = 0; i < elitePool.size(); i++){
+		getSchedule(elitePool[i], papers);
+		checkpoint.putPapers(papers);
+	}
+
+	checkpoint.putInteger(beam == NULL ? 0 : beam->size());
+	if(beam != NULL){
+		checkpoint.putInteger(iterations);
+		getSchedule(*optimalConference, papers);
+		checkpoint.putPapers(papers);
+		for(int i = 0; i < beam->size(); i++){
+			getSchedule((*beam)[i], papers);
+			checkpoint.putPapers(papers);
+		}
+	}
+
+	checkpoint.save(getCheckpointFileName());
+}
+
+bool SessionOrganizer::loadCheckpoint()
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	long long tracks, sessions, papersPerSession, restarts, elites, beamMembers, iterations;
+	double tradeoff, elapsed;
+	string mode, generatorState;
+	vector<int> papers;
+
+	if(!checkpoint.load(getCheckpointFileName())){
+		cout << "Could not read a checkpoint from " << getCheckpointFileName() << ", starting afresh" << endl;
+		return false;
+	}
+
+	if(!checkpoint.getInteger(tracks) || !checkpoint.getInteger(sessions) || !checkpoint.getInteger(papersPerSession)
+		|| !checkpoint.getDouble(tradeoff) || tracks != parallelTracks || sessions != sessionsInTrack
+		|| papersPerSession != papersInSession || tradeoff != tradeoffCoefficient){
+		cout << "The checkpoint is of another instance, starting afresh" << endl;
+		return false;
+	}
+
+	// every schedule is checked and rescored before the search uses it
+	Conference best;
+	if(!checkpoint.getString(mode) || !checkpoint.getDouble(elapsed) || !checkpoint.getString(generatorState)
+		|| !checkpoint.getInteger(restarts) || !checkpoint.getPapers(papers)
+		|| papers.size() != totalNumberOfPapers || !setSchedule(papers, best) || !checkpoint.getInteger(elites)
+		|| elites < 0 || elites > ELITE_POOL_SIZE){
+		cout << "The checkpoint is damaged, starting afresh" << endl;
+		return false;
+	}
+
+	vector<Conference> pool(elites);
+	for(int i = 0; i < elites; i++){
+		if(!checkpoint.getPapers(papers) || papers.size() != totalNumberOfPapers || !setSchedule(papers, pool[i])){
+			cout << "The checkpoint is damaged, starting afresh" << endl;
+			return false;
+		}
+	}
+
+	vector<Conference> beam;
+	Conference optimal;
+	iterations = 0;
+	// a beam search never keeps more members than its beam size
+	if(!checkpoint.getInteger(beamMembers) || beamMembers < 0 || beamMembers > beamSize
+		|| (beamMembers > 0 && (!checkpoint.getInteger(iterations)
+		|| !checkpoint.getPapers(papers) || papers.size() != totalNumberOfPapers || !setSchedule(papers, optimal)))){
+		cout << "The checkpoint is damaged, starting afresh" << endl;
+		return false;
+	}
+	beam.resize(beamMembers);
+	for(int i = 0; i < beamMembers; i++){
+		if(!checkpoint.getPapers(papers) || papers.size() != totalNumberOfPapers || !setSchedule(papers, beam[i])){
+			cout << "The checkpoint is damaged, starting afresh" << endl;
+			return false;
+		}
+	}
+	checkpoint.clear();
+
+	// the output file holds any better conference found after the checkpoint
+	Conference written(parallelTracks, sessionsInTrack, papersInSession);
+	if(readInScheduleFile(outputFileName, written) && repairOrganization(written) == 0){
+		scoreConference(written);
+		if(written.getScore() > best.getScore())
+			best = written;
+	}
+
+	istringstream generatorStream(generatorState);
+	generatorStream >> randomGenerator;
+	srand(randomGenerator());
+
+	// the search gets what is left of the time of the checkpointed run
+	starting_time = time(0) - (time_t)elapsed;
+	lastCheckpointTime = time(0);
+	*conference = best;
+	elitePool.swap(pool);
+	numberOfRestarts = restarts;
+
+	// the beam is only continued by a beam search, other searches start from the best conference
+	if(mode == searchMode && !beam.empty()){
+		resumedBeam.swap(beam);
+		resumedOptimalConference = optimal;
+		resumedIterations = iterations;
+	}
+
+	cout << "Resumed the " << mode << " search after " << elapsed << " seconds at score "
+		<< getReportedScore(best.getScore()) << endl;
+	return true;
+}
+
+void SessionOrganizer::localBeamSearch(int beamSize, bool warmStart) {
+	vector<Conference> beam;
+	vector<Conference> beamNeighbours;
+	SwapBatch batch;
+	int maximumNumberOfIterations = 0;
+
+	// restarts build on the local optima of the earlier beams
+	bool restart = !warmStart && !elitePool.empty();
+	bool resumed = !resumedBeam.empty();
+	if(resumed)
+		*this->conference = resumedOptimalConference;
+	else if(restart)
+		generateRestart(*this->conference);
+	else if(!warmStart)
+		initializeOrganization(this->conference);
+	double maximumScore = this->conference->getScore();
+	
+	Conference optimalConference = *(this->conference);
+
+	if(resumed){
+		// continue the beam of the checkpoint where it stopped
+		beam.swap(resumedBeam);
+		maximumNumberOfIterations = resumedIterations;
+	}
+
+	for(int i=beam.size(); i<beamSize; i++){
+		Conference newConference = *conference;
+		if(!warmStart && !restart){
+			initializeOrganization(&newConference);
+		}else if(i > 0){
+			// spread the beam around the starting schedule
+			swapTwoRandomPapers(&newConference);
+		}
+		beam.push_back(newConference);
+	}
+
+	// rotations are copied before they are checked, so they get a small share
+	MoveSampler sampler(1.0 - ROTATION_TIME_SHARE, ROTATION_TIME_SHARE, 0.0);
+
+	double time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);				// time left in seconds
+	double max_iteration_time = 0;																	// in seconds
+
+	do {
+		time_t iteration_start = time(0);
+
+		cout << endl;
+		cout << "Time Left : " << time_left << endl;
+		cout << "iteration = " << maximumNumberOfIterations << endl;
+
+		// continue with the changed distance matrix without rescoring the beam
+		if(applyPendingDistanceUpdates(beam, optimalConference)){
+			maximumScore = optimalConference.getScore();
+		}
+
+		// once the beam is full, a swap neighbour scoring below its worst member
+		// can not make the next beam, and is not copied
+		set<unsigned long long> memberHashes;
+		double worstMemberScore = -numeric_limits<double>::max();
+		for(int i=0; i<beam.size(); i++){
+			memberHashes.insert(beam[i].getHash());
+		}
+		if(memberHashes.size() >= beamSize){
+			worstMemberScore = beam[0].getScore();
+			for(int i=1; i<beam.size(); i++){
+				worstMemberScore = min(worstMemberScore, beam[i].getScore());
+			}
+		}
+
+		for(int i=0; i<beam.size(); i++){
+			Conference tmpConference = beam[i];
+			beamNeighbours.push_back(tmpConference);
+
+			for(int j=0; j<beamSize; j++){
+				MoveSampler::MoveType move = sampler.nextMove();
+				chrono::steady_clock::time_point moveStart = chrono::steady_clock::now();
+
+				PaperSlot slots[3];
+				if(move == MoveSampler::ROTATION_MOVE){
+					if(pickRotation(beam[i], randomGenerator, slots) && isRotationFeasible(beam[i], slots, 3)){
+						Conference neighbourConference = beam[i];
+						rotatePapers(neighbourConference, slots, 3);
+						if(!visitedStates.insert(neighbourConference.getHash()))
+							beamNeighbours.push_back(neighbourConference);
+					}
+					sampler.recordMove(move, chrono::duration<double>(chrono::steady_clock::now() - moveStart).count());
+					continue;
+				}
+
+				int trackIndex1, sessionIndex1, paperIndex1;
+				int trackIndex2, sessionIndex2, paperIndex2;
+				pickSwap(beam[i], randomGenerator, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+
+				// the swaps are scored in batches, those breaking a constraint are dropped
+				if(isSwapFeasible(beam[i], trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2))
+					batch.addMove(beam[i], trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+				if(batch.getNumberOfMoves() == SWAP_BATCH_SIZE)
+					addSwapNeighbours(beam[i], batch, worstMemberScore, beamNeighbours);
+				sampler.recordMove(move, chrono::duration<double>(chrono::steady_clock::now() - moveStart).count());
+			}
+			addSwapNeighbours(beam[i], batch, worstMemberScore, beamNeighbours);
+		}
+
+
+		sort(beamNeighbours.begin(),beamNeighbours.end());
+
+		int neighboursSize = beamNeighbours.size();
+
+		if(beamNeighbours[neighboursSize-1].getScore() > maximumScore){
+			maximumScore = beamNeighbours[neighboursSize-1].getScore();
+			optimalConference = beamNeighbours[neighboursSize-1];
+			cout << "Increased to " << getReportedScore(optimalConference.getScore()) << endl;
+
+			time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
+			
+			// don't overwrite the outputfile if time is up
+			if(time_left <= 1.0){
+				exit(0);
+			}
+
+			if(optimalConference.getScore() > globalMaximumScore){
+				globalMaximumScore = optimalConference.getScore();
+				bestConference = optimalConference;
+				writeConference(optimalConference);
+				if(isGapClosed())
+					exit(0);
+			}
+
+			maximumNumberOfIterations = 0;
+		}else{
+			cout << "nhi badh rha h" << endl;
+			maximumNumberOfIterations++;
+		}
+
+		beam.clear();
+
+		// the best distinct conferences form the next beam
+		set<unsigned long long> beamHashes;
+		for(int i=neighboursSize-1; i>=0 && beam.size()<beamSize; i--){
+			if(beamHashes.insert(beamNeighbours[i].getHash()).second){
+				beam.push_back(beamNeighbours[i]);
+			}
+		}
+
+		beamNeighbours.clear();
+
+		// an immigrant from another island takes the place of the worst member
+		Conference immigrant;
+		if(exchangeWithIslands(optimalConference, immigrant) && !beam.empty()){
+			beam.back() = immigrant;
+		}
+
+		// correct the scores kept by swaps against full rescores
+		if(isScoreAuditDue()){
+			for(int i=0; i<beam.size(); i++){
+				auditScore(beam[i]);
+			}
+			auditScore(optimalConference);
+			maximumScore = optimalConference.getScore();
+			auditBestScore();
+		}
+
+		saveCheckpoint(&beam, &optimalConference, maximumNumberOfIterations);
+
+		max_iteration_time = max(max_iteration_time, difftime(time(0), iteration_start));
+		time_left = processingTimeInMinutes*60 - difftime(time(0), starting_time);
+		
+		if (time_left < max_iteration_time) {
+			exit(0);
+		}
+
+	} while (maximumNumberOfIterations < staleIterations);
+
+	if(offerElite(optimalConference)){
+		cout << "Elite pool of " << elitePool.size() << " conferences, best " << getReportedScore(elitePool[0].getScore()) << endl;
+	}
+}
+
+void SessionOrganizer::addSwapNeighbours(Conference &conference, SwapBatch &batch, double minimumScore, vector<Conference> &neighbours)
+{
+	int trackIndex1, sessionIndex1, paperIndex1;
+	int trackIndex2, sessionIndex2, paperIndex2;
+
+	evaluateSwapBatch(conference, batch);
+
+	// skip neighbours that can not make the beam or were explored before, without copying them
+	for(int move=0; move<batch.getNumberOfMoves(); move++){
+		if(conference.getScore() + batch.getDelta(move) < minimumScore)
+			continue;
+		batch.getMove(move, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		if(visitedStates.insert(conference.getHashAfterSwap(trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2)))
+			continue;
+
+		Conference neighbourConference = conference;
+		swapPapers(neighbourConference, trackIndex1, sessionIndex1, paperIndex1, trackIndex2, sessionIndex2, paperIndex2);
+		neighbours.push_back(neighbourConference);
+	}
+	batch.clear();
+}
+
+bool SessionOrganizer::offerElite(Conference &conference)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	int minimumDistance = max(1, totalNumberOfPapers / 10);
+
+	int nearest = -1;
+	int nearestDistance = INT_MAX;
+	for(int i = 0; i < elitePool.size(); i++){
+		int distance = getSessionDistance(conference, elitePool[i]);
+		if(distance < nearestDistance){
+			nearestDistance = distance;
+			nearest = i;
+		}
+	}
+
+	// clones are dropped, near clones compete with their nearest elite
+	if(nearestDistance == 0)
+		return false;
+
+	if(nearestDistance < minimumDistance){
+		if(conference.getScore() <= elitePool[nearest].getScore())
+			return false;
+		elitePool[nearest] = conference;
+	}else if(elitePool.size() < ELITE_POOL_SIZE){
+		elitePool.push_back(conference);
+	}else{
+		if(conference.getScore() <= elitePool.back().getScore())
+			return false;
+		elitePool.back() = conference;
+	}
+
+	// best first
+	sort(elitePool.rbegin(), elitePool.rend());
+	return true;
+}
+
+void SessionOrganizer::alignConference(Conference &reference, Conference &conference, Conference &aligned)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	// papers shared by every pair of time slots, and by every pair of sessions
+	vector<int> slotOverlap(sessionsInTrack * sessionsInTrack, 0);
+	vector<int> sessionOverlap(parallelTracks * sessionsInTrack * parallelTracks * sessionsInTrack, 0);
+	for(int paperId = 0; paperId < totalNumberOfPapers; paperId++){
+		int trackIndex1, sessionIndex1, paperIndex1;
+		int trackIndex2, sessionIndex2, paperIndex2;
+		conference.getPaperLocation(paperId, trackIndex1, sessionIndex1, paperIndex1);
+		reference.getPaperLocation(paperId, trackIndex2, sessionIndex2, paperIndex2);
+		slotOverlap[sessionIndex1 * sessionsInTrack + sessionIndex2]++;
+		sessionOverlap[(trackIndex1 * sessionsInTrack + sessionIndex1) * parallelTracks * sessionsInTrack + trackIndex2 * sessionsInTrack + sessionIndex2]++;
+	}
+
+	// time slots are matched greedily by the papers they share
+	vector< pair<int, int> > pairs;
+	for(int i = 0; i < sessionsInTrack * sessionsInTrack; i++){
+		pairs.push_back(make_pair(-slotOverlap[i], i));
+	}
+	sort(pairs.begin(), pairs.end());
+
+	vector<int> slotOf(sessionsInTrack, -1);
+	vector<bool> slotTaken(sessionsInTrack, false);
+	for(int i = 0; i < pairs.size(); i++){
+		int sessionIndex1 = pairs[i].second / sessionsInTrack;
+		int sessionIndex2 = pairs[i].second % sessionsInTrack;
+		if(slotOf[sessionIndex1] >= 0 || slotTaken[sessionIndex2])
+			continue;
+		slotOf[sessionIndex1] = sessionIndex2;
+		slotTaken[sessionIndex2] = true;
+	}
+
+	aligned = Conference(parallelTracks, sessionsInTrack, papersInSession);
+	for(int sessionIndex1 = 0; sessionIndex1 < sessionsInTrack; sessionIndex1++){
+		int sessionIndex2 = slotOf[sessionIndex1];
+
+		// and the tracks of matched time slots likewise
+		pairs.clear();
+		for(int trackIndex1 = 0; trackIndex1 < parallelTracks; trackIndex1++){
+			for(int trackIndex2 = 0; trackIndex2 < parallelTracks; trackIndex2++){
+				int overlap = sessionOverlap[(trackIndex1 * sessionsInTrack + sessionIndex1) * parallelTracks * sessionsInTrack + trackIndex2 * sessionsInTrack + sessionIndex2];
+				pairs.push_back(make_pair(-overlap, trackIndex1 * parallelTracks + trackIndex2));
+			}
+		}
+		sort(pairs.begin(), pairs.end());
+
+		vector<int> trackOf(parallelTracks, -1);
+		vector<bool> trackTaken(parallelTracks, false);
+		for(int i = 0; i < pairs.size(); i++){
+			int trackIndex1 = pairs[i].second / parallelTracks;
+			int trackIndex2 = pairs[i].second % parallelTracks;
+			if(trackOf[trackIndex1] >= 0 || trackTaken[trackIndex2])
+				continue;
+			trackOf[trackIndex1] = trackIndex2;
+			trackTaken[trackIndex2] = true;
+
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++){
+				aligned.setPaper(trackIndex2, sessionIndex2, paperIndex, conference.getPaper(trackIndex1, sessionIndex1, paperIndex));
+			}
+		}
+	}
+
+	scoreConference(aligned);
+}
+
+bool SessionOrganizer::relinkConferences(Conference &from, Conference &to, Conference &result, mt19937 &generator)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+
+	// the session of every paper in the target, and the papers not yet in it
+	vector<int> targetSession(totalNumberOfPapers);
+	vector<int> misplaced;
+	vector<int> misplacedIndex(totalNumberOfPapers, -1);
+	for(int paperId = 0; paperId < totalNumberOfPapers; paperId++){
+		int trackIndex1, sessionIndex1, paperIndex1;
+		int trackIndex2, sessionIndex2, paperIndex2;
+		from.getPaperLocation(paperId, trackIndex1, sessionIndex1, paperIndex1);
+		to.getPaperLocation(paperId, trackIndex2, sessionIndex2, paperIndex2);
+		targetSession[paperId] = trackIndex2 * sessionsInTrack + sessionIndex2;
+		if(targetSession[paperId] != trackIndex1 * sessionsInTrack + sessionIndex1){
+			misplacedIndex[paperId] = misplaced.size();
+			misplaced.push_back(paperId);
+		}
+	}
+
+	Conference current = from;
+	bool found = false;
+
+	while(!misplaced.empty()){
+		bool chosen = false;
+		double bestScore = 0.0;
+		PaperSlot bestSlots[2];
+
+		for(int candidate = 0; candidate < RELINK_CANDIDATES; candidate++){
+			int paperId = misplaced[generator() % misplaced.size()];
+			PaperSlot slots[2];
+			current.getPaperLocation(paperId, slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex);
+			int session = targetSession[paperId];
+			int currentSession = slots[0].trackIndex * sessionsInTrack + slots[0].sessionIndex;
+
+			// the paper trades places with a paper that does not belong to its
+			// target session, best one that belongs where the paper is now
+			slots[1].trackIndex = session / sessionsInTrack;
+			slots[1].sessionIndex = session % sessionsInTrack;
+			slots[1].paperIndex = -1;
+			for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++){
+				int mate = current.getPaper(slots[1].trackIndex, slots[1].sessionIndex, paperIndex);
+				if(targetSession[mate] == currentSession){
+					slots[1].paperIndex = paperIndex;
+					break;
+				}
+				if(targetSession[mate] != session && slots[1].paperIndex < 0)
+					slots[1].paperIndex = paperIndex;
+			}
+
+			double score = getScoreOnSwapping(current, slots[0].trackIndex, slots[0].sessionIndex, slots[0].paperIndex, slots[1].trackIndex, slots[1].sessionIndex, slots[1].paperIndex);
+			if(!chosen || score > bestScore){
+				chosen = true;
+				bestScore = score;
+				bestSlots[0] = slots[0];
+				bestSlots[1] = slots[1];
+			}
+		}
+
+		int paperId1 = current.getPaper(bestSlots[0].trackIndex, bestSlots[0].sessionIndex, bestSlots[0].paperIndex);
+		int paperId2 = current.getPaper(bestSlots[1].trackIndex, bestSlots[1].sessionIndex, bestSlots[1].paperIndex);
+		swapPapers(current, bestSlots[0].trackIndex, bestSlots[0].sessionIndex, bestSlots[0].paperIndex, bestSlots[1].trackIndex, bestSlots[1].sessionIndex, bestSlots[1].paperIndex);
+
+		int paperIds[2] = { paperId1, paperId2 };
+		for(int i = 0; i < 2; i++){
+			int trackIndex, sessionIndex, paperIndex;
+			current.getPaperLocation(paperIds[i], trackIndex, sessionIndex, paperIndex);
+			if(misplacedIndex[paperIds[i]] < 0 || targetSession[paperIds[i]] != trackIndex * sessionsInTrack + sessionIndex)
+				continue;
+
+			// remove from the misplaced papers
+			int last = misplaced.back();
+			misplaced[misplacedIndex[paperIds[i]]] = last;
+			misplacedIndex[last] = misplacedIndex[paperIds[i]];
+			misplaced.pop_back();
+			misplacedIndex[paperIds[i]] = -1;
+		}
+
+		if(!misplaced.empty() && (!found || current.getScore() > result.getScore()) && isConferenceFeasible(current)){
+			found = true;
+			result = current;
+		}
+	}
+
+	return found;
+}
+
+void SessionOrganizer::generateRestart(Conference &restart)
+{
+	int totalNumberOfPapers = parallelTracks * sessionsInTrack * papersInSession;
+	numberOfRestarts++;
+
+	// two of every three restarts relink a pair of elites
+	if(elitePool.size() >= 2 && numberOfRestarts % 3 != 0){
+		int elite1 = randomGenerator() % elitePool.size();
+		int elite2 = randomGenerator() % (elitePool.size() - 1);
+		if(elite2 >= elite1)
+			elite2++;
+
+		Conference aligned;
+		alignConference(elitePool[elite1], elitePool[elite2], aligned);
+		if(relinkConferences(elitePool[elite1], aligned, restart, randomGenerator)){
+			cout << "Restart relinked from elites " << elite1 << " and " << elite2 << " with score " << getReportedScore(restart.getScore()) << endl;
+			return;
+		}
+	}
+
+	// the others perturb an elite by random swaps
+	restart = elitePool[randomGenerator() % elitePool.size()];
+	int numberOfSwaps = max(2, totalNumberOfPapers / 10);
+	for(int i = 0; i < numberOfSwaps; i++){
+		swapTwoRandomPapers(&restart);
+	}
+	cout << "Restart perturbed from an elite with score " << getReportedScore(restart.getScore()) << endl;
+}
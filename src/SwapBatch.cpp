@@ -0,0 +1,297 @@
+/*
+ * File:   SwapBatch.cpp
+ *
+ */
+
+#include "SwapBatch.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SWAP_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+SwapBatch::SwapBatch()
+{
+    numberOfMoves = 0;
+    papersInSession = 0;
+    positionsInSlot = 0;
+}
+
+void SwapBatch::clear()
+{
+    numberOfMoves = 0;
+}
+
+int SwapBatch::getNumberOfMoves()
+{
+    return numberOfMoves;
+}
+
+void SwapBatch::addMove(Conference &conference, int trackIndex1, int sessionIndex1, int paperIndex1, int trackIndex2, int sessionIndex2, int paperIndex2)
+{
+    int move = numberOfMoves++;
+    this->trackIndex1[move] = trackIndex1;
+    this->sessionIndex1[move] = sessionIndex1;
+    this->paperIndex1[move] = paperIndex1;
+    this->trackIndex2[move] = trackIndex2;
+    this->sessionIndex2[move] = sessionIndex2;
+    this->paperIndex2[move] = paperIndex2;
+    paper1[move] = conference.getPaper(trackIndex1, sessionIndex1, paperIndex1);
+    paper2[move] = conference.getPaper(trackIndex2, sessionIndex2, paperIndex2);
+}
+
+void SwapBatch::getMove(int move, int &trackIndex1, int &sessionIndex1, int &paperIndex1, int &trackIndex2, int &sessionIndex2, int &paperIndex2)
+{
+    trackIndex1 = this->trackIndex1[move];
+    sessionIndex1 = this->sessionIndex1[move];
+    paperIndex1 = this->paperIndex1[move];
+    trackIndex2 = this->trackIndex2[move];
+    sessionIndex2 = this->sessionIndex2[move];
+    paperIndex2 = this->paperIndex2[move];
+}
+
+int SwapBatch::prepare(Conference &conference)
+{
+    papersInSession = conference.getPapersInSession();
+    positionsInSlot = conference.getParallelTracks() * papersInSession;
+    slotPapers1.resize(positionsInSlot * SWAP_BATCH_SIZE);
+    slotPapers2.resize(positionsInSlot * SWAP_BATCH_SIZE);
+
+    // the last move is repeated up to the SIMD width, its copies are ignored
+    int paddedMoves = (numberOfMoves + 3) & ~3;
+    for(int move = numberOfMoves; move < paddedMoves; move++)
+    {
+        trackIndex1[move] = trackIndex1[numberOfMoves - 1];
+        sessionIndex1[move] = sessionIndex1[numberOfMoves - 1];
+        trackIndex2[move] = trackIndex2[numberOfMoves - 1];
+        sessionIndex2[move] = sessionIndex2[numberOfMoves - 1];
+        paper1[move] = paper1[numberOfMoves - 1];
+        paper2[move] = paper2[numberOfMoves - 1];
+    }
+
+    for(int move = 0; move < paddedMoves; move++)
+    {
+        for(int trackIndex = 0; trackIndex < conference.getParallelTracks(); trackIndex++)
+        {
+            const int *papers1 = conference.getSession(trackIndex, sessionIndex1[move])->getPapers();
+            const int *papers2 = conference.getSession(trackIndex, sessionIndex2[move])->getPapers();
+            for(int paperIndex = 0; paperIndex < papersInSession; paperIndex++)
+            {
+                int position = trackIndex * papersInSession + paperIndex;
+                slotPapers1[position * SWAP_BATCH_SIZE + move] = papers1[paperIndex];
+                slotPapers2[position * SWAP_BATCH_SIZE + move] = papers2[paperIndex];
+            }
+        }
+    }
+    return paddedMoves;
+}
+
+template<typename T>
+void SwapBatch::evaluateScalar(double similarityWeight, double parallelWeight)
+{
+    for(int move = 0; move < numberOfMoves; move++)
+        deltas[move] = 0.0;
+
+    for(int position = 0; position < positionsInSlot; position++)
+    {
+        int trackIndex = position / papersInSession;
+        const int *others1 = &slotPapers1[position * SWAP_BATCH_SIZE];
+        const int *others2 = &slotPapers2[position * SWAP_BATCH_SIZE];
+        for(int move = 0; move < numberOfMoves; move++)
+        {
+            const T *row1 = (const T*)rowAddresses1[move];
+            const T *row2 = (const T*)rowAddresses2[move];
+
+            // the two swapped papers keep their pair, and are skipped
+            int other = others1[move];
+            double weight = trackIndex == trackIndex1[move] ? similarityWeight : -parallelWeight;
+            if(other != paper1[move] && other != paper2[move])
+                deltas[move] += weight * ((double)row1[other] - (double)row2[other]);
+
+            other = others2[move];
+            weight = trackIndex == trackIndex2[move] ? similarityWeight : -parallelWeight;
+            if(other != paper1[move] && other != paper2[move])
+                deltas[move] += weight * ((double)row2[other] - (double)row1[other]);
+        }
+    }
+}
+
+#ifdef SWAP_BATCH_AVX2
+__attribute__((target("avx2")))
+void SwapBatch::evaluateAvx2(double similarityWeight, double parallelWeight)
+{
+    __m256d similarity = _mm256_set1_pd(similarityWeight);
+    __m256d parallel = _mm256_set1_pd(-parallelWeight);
+
+    for(int move = 0; move < numberOfMoves; move += 4)
+    {
+        __m256i rows1 = _mm256_loadu_si256((const __m256i*)&rowAddresses1[move]);
+        __m256i rows2 = _mm256_loadu_si256((const __m256i*)&rowAddresses2[move]);
+        __m128i tracks1 = _mm_loadu_si128((const __m128i*)&trackIndex1[move]);
+        __m128i tracks2 = _mm_loadu_si128((const __m128i*)&trackIndex2[move]);
+        __m128i papers1 = _mm_loadu_si128((const __m128i*)&paper1[move]);
+        __m128i papers2 = _mm_loadu_si128((const __m128i*)&paper2[move]);
+        __m256d sum = _mm256_setzero_pd();
+
+        for(int position = 0; position < positionsInSlot; position++)
+        {
+            __m128i trackIndex = _mm_set1_epi32(position / papersInSession);
+
+            // the rows are gathered by address, as they need not be in one block
+            __m128i others = _mm_loadu_si128((const __m128i*)&slotPapers1[position * SWAP_BATCH_SIZE + move]);
+            __m256i offsets = _mm256_slli_epi64(_mm256_cvtepi32_epi64(others), 3);
+            __m256d distances1 = _mm256_i64gather_pd((const double*)0, _mm256_add_epi64(rows1, offsets), 1);
+            __m256d distances2 = _mm256_i64gather_pd((const double*)0, _mm256_add_epi64(rows2, offsets), 1);
+            __m128i skipped = _mm_or_si128(_mm_cmpeq_epi32(others, papers1), _mm_cmpeq_epi32(others, papers2));
+            __m256d weights = _mm256_blendv_pd(parallel, similarity, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(trackIndex, tracks1))));
+            weights = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(skipped)), weights);
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(weights, _mm256_sub_pd(distances1, distances2)));
+
+            others = _mm_loadu_si128((const __m128i*)&slotPapers2[position * SWAP_BATCH_SIZE + move]);
+            offsets = _mm256_slli_epi64(_mm256_cvtepi32_epi64(others), 3);
+            distances1 = _mm256_i64gather_pd((const double*)0, _mm256_add_epi64(rows1, offsets), 1);
+            distances2 = _mm256_i64gather_pd((const double*)0, _mm256_add_epi64(rows2, offsets), 1);
+            skipped = _mm_or_si128(_mm_cmpeq_epi32(others, papers1), _mm_cmpeq_epi32(others, papers2));
+            weights = _mm256_blendv_pd(parallel, similarity, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(trackIndex, tracks2))));
+            weights = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(skipped)), weights);
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(weights, _mm256_sub_pd(distances2, distances1)));
+        }
+
+        _mm256_storeu_pd(&deltas[move], sum);
+    }
+}
+
+__attribute__((target("avx2")))
+void SwapBatch::evaluateAvx2Units(int bits, double similarityWeight, double parallelWeight)
+{
+    __m256d similarity = _mm256_set1_pd(similarityWeight);
+    __m256d parallel = _mm256_set1_pd(-parallelWeight);
+
+    // four bytes are gathered at every distance and the bits of the distance kept
+    __m128i mask = _mm_set1_epi32(bits == 8 ? 0xff : 0xffff);
+    __m128i shift = _mm_cvtsi32_si128(bits == 8 ? 0 : 1);
+
+    for(int move = 0; move < numberOfMoves; move += 4)
+    {
+        __m256i rows1 = _mm256_loadu_si256((const __m256i*)&rowAddresses1[move]);
+        __m256i rows2 = _mm256_loadu_si256((const __m256i*)&rowAddresses2[move]);
+        __m128i tracks1 = _mm_loadu_si128((const __m128i*)&trackIndex1[move]);
+        __m128i tracks2 = _mm_loadu_si128((const __m128i*)&trackIndex2[move]);
+        __m128i papers1 = _mm_loadu_si128((const __m128i*)&paper1[move]);
+        __m128i papers2 = _mm_loadu_si128((const __m128i*)&paper2[move]);
+        __m256d sum = _mm256_setzero_pd();
+
+        for(int position = 0; position < positionsInSlot; position++)
+        {
+            __m128i trackIndex = _mm_set1_epi32(position / papersInSession);
+
+            __m128i others = _mm_loadu_si128((const __m128i*)&slotPapers1[position * SWAP_BATCH_SIZE + move]);
+            __m256i offsets = _mm256_sll_epi64(_mm256_cvtepi32_epi64(others), shift);
+            __m256d distances1 = _mm256_cvtepi32_pd(_mm_and_si128(mask, _mm256_i64gather_epi32((const int*)0, _mm256_add_epi64(rows1, offsets), 1)));
+            __m256d distances2 = _mm256_cvtepi32_pd(_mm_and_si128(mask, _mm256_i64gather_epi32((const int*)0, _mm256_add_epi64(rows2, offsets), 1)));
+            __m128i skipped = _mm_or_si128(_mm_cmpeq_epi32(others, papers1), _mm_cmpeq_epi32(others, papers2));
+            __m256d weights = _mm256_blendv_pd(parallel, similarity, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(trackIndex, tracks1))));
+            weights = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(skipped)), weights);
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(weights, _mm256_sub_pd(distances1, distances2)));
+
+            others = _mm_loadu_si128((const __m128i*)&slotPapers2[position * SWAP_BATCH_SIZE + move]);
+            offsets = _mm256_sll_epi64(_mm256_cvtepi32_epi64(others), shift);
+            distances1 = _mm256_cvtepi32_pd(_mm_and_si128(mask, _mm256_i64gather_epi32((const int*)0, _mm256_add_epi64(rows1, offsets), 1)));
+            distances2 = _mm256_cvtepi32_pd(_mm_and_si128(mask, _mm256_i64gather_epi32((const int*)0, _mm256_add_epi64(rows2, offsets), 1)));
+            skipped = _mm_or_si128(_mm_cmpeq_epi32(others, papers1), _mm_cmpeq_epi32(others, papers2));
+            weights = _mm256_blendv_pd(parallel, similarity, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(trackIndex, tracks2))));
+            weights = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(skipped)), weights);
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(weights, _mm256_sub_pd(distances2, distances1)));
+        }
+
+        _mm256_storeu_pd(&deltas[move], sum);
+    }
+}
+#else
+void SwapBatch::evaluateAvx2(double similarityWeight, double parallelWeight)
+{
+    evaluateScalar<double>(similarityWeight, parallelWeight);
+}
+
+void SwapBatch::evaluateAvx2Units(int bits, double similarityWeight, double parallelWeight)
+{
+    if(bits == 8)
+        evaluateScalar<unsigned char>(similarityWeight, parallelWeight);
+    else
+        evaluateScalar<unsigned short>(similarityWeight, parallelWeight);
+}
+#endif
+
+void SwapBatch::evaluate(Conference &conference, double **distanceMatrix, double similarityWeight, double parallelWeight)
+{
+    if(numberOfMoves == 0)
+        return;
+
+    int paddedMoves = prepare(conference);
+    for(int move = 0; move < paddedMoves; move++)
+    {
+        rowAddresses1[move] = (long long)distanceMatrix[paper1[move]];
+        rowAddresses2[move] = (long long)distanceMatrix[paper2[move]];
+    }
+
+#ifdef SWAP_BATCH_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if(hasAvx2)
+    {
+        evaluateAvx2(similarityWeight, parallelWeight);
+        return;
+    }
+#endif
+    evaluateScalar<double>(similarityWeight, parallelWeight);
+}
+
+void SwapBatch::evaluate(Conference &conference, QuantizedDistanceMatrix &quantizedMatrix, double similarityWeight, double parallelWeight)
+{
+    if(numberOfMoves == 0)
+        return;
+
+    // the rows of the copy of the distances on the node of this thread
+    int paddedMoves = prepare(conference);
+    int bits = quantizedMatrix.getBits();
+    const char *distances = (const char*)quantizedMatrix.getDistances();
+    size_t rowSize = (size_t)conference.getParallelTracks() * conference.getSessionsInTrack() * conference.getPapersInSession() * (bits / 8);
+    for(int move = 0; move < paddedMoves; move++)
+    {
+        rowAddresses1[move] = (long long)(distances + paper1[move] * rowSize);
+        rowAddresses2[move] = (long long)(distances + paper2[move] * rowSize);
+    }
+
+#ifdef SWAP_BATCH_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if(hasAvx2)
+    {
+        evaluateAvx2Units(bits, similarityWeight, parallelWeight);
+        return;
+    }
+#endif
+    if(bits == 8)
+        evaluateScalar<unsigned char>(similarityWeight, parallelWeight);
+    else
+        evaluateScalar<unsigned short>(similarityWeight, parallelWeight);
+}
+
+double SwapBatch::getDelta(int move)
+{
+    return deltas[move];
+}
+
+void SwapBatch::setDelta(int move, double delta)
+{
+    deltas[move] = delta;
+}
+
+int SwapBatch::getBestMove()
+{
+    int best = numberOfMoves > 0 ? 0 : -1;
+    for(int move = 1; move < numberOfMoves; move++)
+    {
+        if(deltas[move] > deltas[best])
+            best = move;
+    }
+    return best;
+}
@@ -0,0 +1,56 @@
+/*
+ * File:   VisitedStateCache.cpp
+ *
+ */
+
+#include <algorithm>
+
+#include "VisitedStateCache.h"
+
+// hashes per bucket
+#define BUCKET_SIZE 4
+
+VisitedStateCache::VisitedStateCache(int log2Entries)
+{
+    unsigned long long numberOfBuckets = max(1ULL, (1ULL << log2Entries) / BUCKET_SIZE);
+    bucketMask = numberOfBuckets - 1;
+    entries = new atomic<unsigned long long>[numberOfBuckets * BUCKET_SIZE];
+    clear();
+}
+
+VisitedStateCache::~VisitedStateCache()
+{
+    delete [] entries;
+}
+
+bool VisitedStateCache::insert(unsigned long long hash)
+{
+    // 0 marks an empty entry
+    if(hash == 0)
+        hash = 1;
+
+    atomic<unsigned long long> *bucket = &entries[(hash & bucketMask) * BUCKET_SIZE];
+    for(int i = 0; i < BUCKET_SIZE; i++)
+    {
+        unsigned long long entry = bucket[i].load(memory_order_relaxed);
+        if(entry == hash)
+            return true;
+        if(entry == 0)
+        {
+            bucket[i].store(hash, memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // full bucket, overwrite an entry chosen by the high bits
+    bucket[(hash >> 62) % BUCKET_SIZE].store(hash, memory_order_relaxed);
+    return false;
+}
+
+void VisitedStateCache::clear()
+{
+    for(unsigned long long i = 0; i < (bucketMask + 1) * BUCKET_SIZE; i++)
+    {
+        entries[i].store(0, memory_order_relaxed);
+    }
+}
@@ -1,51 +1,119 @@
-/* 
- * File:   main.cpp
- * Author: Harishchandra Patidar
- *
- */
-
-#include <cstdlib>
-#include <time.h>
-#include <stdlib.h>
-
-#include "SessionOrganizer.h"
-
-using namespace std;
-
-int main(int argc, char** argv)
-{
-    time_t starting_time = time(0);
-    // Parse the input.
-    if (argc < 2)
-    {
-        cout << "./a.out <input_filename> <output_filename>";
-        exit(0);
-    }
-
-    srand(time(NULL));
-    
-    string inputFileName(argv[1]);
-    string outputFileName(argv[2]);
-
-    // Initialize the conference organizer.
-    SessionOrganizer *organizer  = new SessionOrganizer(inputFileName, outputFileName, starting_time);
-
-    // Organize the papers into tracks based on similarity.
-    organizer->organizePapers();
-    
-    cout << "organization:"<<endl;
-    organizer->printSessionOrganiser();
-
-    // Score the organization against the gold standard.
-    double score = organizer->getConferenceScore();
-    cout<< "score:"<<score<<endl;
-
-    return 0;
-}
-
-// 125 papers -> 979.686 for complete swappings
-// 125 papers -> 968.638 for taking minimum distance neighbour from each session and swapping with maximum distance neighbour in current session
-// 125 papers -> 970.488 for picking random paper from each session for every paper in a given session
-
-// testfile3 -> 479-480 (random neighbour and initializeOrganization())
+/* 
+ * File:   main.cpp
+ * Author: Harishchandra Patidar
+ *
+ */
+
+#include <cstdlib>
+#include <time.h>
+#include <stdlib.h>
+
+#include "SessionOrganizer.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    time_t starting_time = time(0);
+    // Parse the input.
+    if (argc < 3)
+    {
+        cout << "./a.out <input_filename> <output_filename> [--mode beam|exact|memetic|lns|climb|portfolio|benchmark] [--warm-start <schedule_filename>] [--updates <updates_filename>] [--distances quantized|double] [--memory default|thp|hugetlb|interleave|replicate] [--island <name>] [--gap <fraction>] [--tuning <table_filename>] [--constraints <constraints_filename>] [--time <minutes>] [--seed <number>] [--resume]";
+        exit(0);
+    }
+
+    string inputFileName(argv[1]);
+    string outputFileName(argv[2]);
+
+    // The island model is joined while the input file is read, and the
+    // seed is set before the organizer seeds its generators.
+    string islandName;
+    unsigned int seed = time(NULL);
+    for (int i = 3; i + 1 < argc; i++)
+    {
+        if (string(argv[i]) == "--island")
+            islandName = argv[i + 1];
+        if (string(argv[i]) == "--seed")
+            seed = strtoul(argv[i + 1], NULL, 10);
+    }
+
+    srand(seed);
+
+    // Initialize the conference organizer.
+    SessionOrganizer *organizer  = new SessionOrganizer(inputFileName, outputFileName, starting_time, islandName);
+
+    // Parse the options.
+    for (int i = 3; i < argc; i++)
+    {
+        string option(argv[i]);
+        if (option == "--warm-start" && i + 1 < argc)
+        {
+            organizer->setWarmStartFile(argv[++i]);
+        }
+        else if (option == "--mode" && i + 1 < argc)
+        {
+            organizer->setSearchMode(argv[++i]);
+        }
+        else if (option == "--updates" && i + 1 < argc)
+        {
+            organizer->setUpdatesFile(argv[++i]);
+        }
+        else if (option == "--distances" && i + 1 < argc)
+        {
+            organizer->setDistanceStorage(argv[++i]);
+        }
+        else if (option == "--memory" && i + 1 < argc)
+        {
+            organizer->setMemoryPolicy(argv[++i]);
+        }
+        else if (option == "--gap" && i + 1 < argc)
+        {
+            organizer->setGapThreshold(atof(argv[++i]));
+        }
+        else if (option == "--constraints" && i + 1 < argc)
+        {
+            organizer->setConstraintsFile(argv[++i]);
+        }
+        else if (option == "--tuning" && i + 1 < argc)
+        {
+            organizer->setTuningFile(argv[++i]);
+        }
+        else if (option == "--time" && i + 1 < argc)
+        {
+            organizer->setProcessingTime(atof(argv[++i]));
+        }
+        else if (option == "--resume")
+        {
+            organizer->setResume(true);
+        }
+        else if ((option == "--island" || option == "--seed") && i + 1 < argc)
+        {
+            i++;
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            exit(0);
+        }
+    }
+
+    // Organize the papers into tracks based on similarity.
+    organizer->organizePapers();
+    
+    cout << "organization:"<<endl;
+    organizer->printSessionOrganiser();
+
+    // Score the organization against the gold standard.
+    double score = organizer->getConferenceScore();
+    cout<< "score:"<<score<<endl;
+    cout<< "optimality gap at most:"<<organizer->getOptimalityGap()<<endl;
+
+    return 0;
+}
+
+// 125 papers -> 979.686 for complete swappings
+// 125 papers -> 968.638 for taking minimum distance neighbour from each session and swapping with maximum distance neighbour in current session
+// 125 papers -> 970.488 for picking random paper from each session for every paper in a given session
+
+// testfile3 -> 479-480 (random neighbour and initializeOrganization())
 // testfile2 -> 344-345 (random neighbour and initializeOrganization())
\ No newline at end of file